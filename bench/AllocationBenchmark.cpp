@@ -0,0 +1,89 @@
+// bench/AllocationBenchmark.cpp
+//
+// Counts heap allocations on the per-frame simulation paths of a large random circuit: full
+// evaluation through the bytecode program and the netlist, and propagation of single input
+// toggles. Once the netlist is compiled these must not allocate; exits with 1 if they do.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "engine/BytecodeEvaluator.h"
+#include "engine/Netlist.h"
+
+namespace {
+
+const size_t INPUTS = 64;
+const size_t GATES = 20000;
+const size_t OUTPUTS = 32;
+const size_t TOGGLES = 10000;
+const size_t FULL_EVALUATIONS = 1000;
+
+size_t allocations = 0;
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+    ++allocations;
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+    // Inputs, then gates reading two earlier gates, then OUTPUT gates on the last ones
+    const GateType logic[] = {GateType::AND, GateType::OR, GateType::NAND, GateType::NOR, GateType::XOR, GateType::NOT};
+    std::mt19937 rng(9);
+    std::vector<Gate> gates;
+    std::vector<Wire> wires;
+    for (size_t i = 0; i < INPUTS; ++i) gates.emplace_back(GateType::INPUT, sf::Vector2f{});
+    for (size_t g = INPUTS; g < INPUTS + GATES; ++g) {
+        const GateType type = logic[rng() % 6];
+        gates.emplace_back(type, sf::Vector2f{});
+        wires.emplace_back(rng() % g, -1, g, 0);
+        if (type != GateType::NOT) wires.emplace_back(rng() % g, -1, g, 1);
+    }
+    for (size_t o = 0; o < OUTPUTS; ++o) {
+        gates.emplace_back(GateType::OUTPUT, sf::Vector2f{});
+        wires.emplace_back(INPUTS + GATES - 1 - o, -1, gates.size() - 1, 0);
+    }
+
+    Netlist netlist;
+    netlist.build(gates, wires);
+    BytecodeEvaluator program;
+    program.compile(netlist, true);
+    std::vector<uint64_t> words(netlist.signalCount(), 0);
+    std::vector<uint64_t> registers(program.registerCount(), 0);
+    std::vector<uint8_t> values(netlist.signalCount(), 0);
+    std::vector<uint32_t> changed;
+    changed.reserve(netlist.gateCount());
+
+    const size_t before = allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t e = 0; e < FULL_EVALUATIONS; ++e) {
+        program.run(words.data(), registers.data(), 1);
+        netlist.evaluate(values);
+    }
+    const auto evaluated = std::chrono::steady_clock::now();
+    size_t flipped = 0;
+    for (size_t t = 0; t < TOGGLES; ++t) {
+        const uint32_t input = netlist.getInputs()[rng() % INPUTS];
+        values[input] ^= 1;
+        changed.clear();
+        netlist.propagate(values, input, changed);
+        flipped += changed.size();
+    }
+    const auto propagated = std::chrono::steady_clock::now();
+    const size_t counted = allocations - before;
+
+    auto ms = [](auto from, auto to) { return std::chrono::duration<double, std::milli>(to - from).count(); };
+    std::printf("%zu gates: %zu full evaluations in %.1f ms, %zu toggles (%zu gates flipped) in %.1f ms\n", netlist.gateCount(),
+                FULL_EVALUATIONS, ms(start, evaluated), TOGGLES, flipped, ms(evaluated, propagated));
+    std::printf("%zu heap allocations\n", counted);
+    return counted == 0 ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+// engine/Aig.cpp
+
+#include "Aig.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr size_t INITIAL_TABLE_SIZE = size_t(1) << 10;
+
+}  // namespace
+
+Aig::Aig() {
+    nodes.push_back({ZERO, ZERO});
+    table.assign(INITIAL_TABLE_SIZE, 0);
+}
+
+Aig::Edge Aig::createInput() {
+    uint32_t node = static_cast<uint32_t>(nodes.size());
+    nodes.push_back({INPUT_MARK, static_cast<Edge>(inputs.size())});
+    inputs.push_back(node);
+    return node << 1;
+}
+
+size_t Aig::slotOf(Edge a, Edge b) const {
+    uint64_t h = (uint64_t(a) << 32 | b) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(h >> 32) & (table.size() - 1);
+}
+
+Aig::Edge Aig::createAnd(Edge a, Edge b) {
+    if (a > b) std::swap(a, b);
+    if (a == ZERO || a == negate(b)) return ZERO;
+    if (a == ONE || a == b) return b;
+
+    size_t slot = slotOf(a, b);
+    for (; table[slot] != 0; slot = (slot + 1) & (table.size() - 1)) {
+        const Node &node = nodes[table[slot]];
+        if (node.fanin0 == a && node.fanin1 == b) return table[slot] << 1;
+    }
+
+    uint32_t node = static_cast<uint32_t>(nodes.size());
+    nodes.push_back({a, b});
+    table[slot] = node;
+    if (2 * andCount() > table.size()) grow();
+    return node << 1;
+}
+
+Aig::Edge Aig::createXor(Edge a, Edge b) {
+    // a ^ b = ~(~(a & ~b) & ~(~a & b))
+    Edge onlyA = createAnd(a, negate(b));
+    Edge onlyB = createAnd(negate(a), b);
+    return createOr(onlyA, onlyB);
+}
+
+void Aig::grow() {
+    table.assign(2 * table.size(), 0);
+    for (uint32_t n = 1; n < nodes.size(); ++n) {
+        if (!isAnd(n)) continue;
+        size_t slot = slotOf(nodes[n].fanin0, nodes[n].fanin1);
+        while (table[slot] != 0) slot = (slot + 1) & (table.size() - 1);
+        table[slot] = n;
+    }
+}
+
+void Aig::simulate(uint64_t *values, size_t words) const {
+    std::fill_n(values, words, 0);
+    for (uint32_t n = 1; n < nodes.size(); ++n) {
+        const Node &node = nodes[n];
+        if (node.fanin0 == INPUT_MARK) continue;
+        const uint64_t *a = values + nodeOf(node.fanin0) * words;
+        const uint64_t *b = values + nodeOf(node.fanin1) * words;
+        const uint64_t maskA = (node.fanin0 & 1) ? ~uint64_t(0) : 0;
+        const uint64_t maskB = (node.fanin1 & 1) ? ~uint64_t(0) : 0;
+        uint64_t *d = values + size_t(n) * words;
+        for (size_t w = 0; w < words; ++w) d[w] = (a[w] ^ maskA) & (b[w] ^ maskB);
+    }
+}
+
+std::vector<Aig::Edge> lowerNetlist(Aig &aig, const Netlist &netlist, const std::vector<Aig::Edge> &inputs) {
+    std::vector<Aig::Edge> edges(netlist.signalCount(), Aig::ZERO);
+    std::vector<uint32_t> inputIndex(netlist.gateCount(), 0);
+    for (size_t i = 0; i < netlist.getInputs().size(); ++i) inputIndex[netlist.getInputs()[i]] = static_cast<uint32_t>(i);
+
+    for (uint32_t g : netlist.getOrder()) {
+        const uint32_t *pin = netlist.faninBegin(g);
+        const uint32_t *end = netlist.faninEnd(g);
+        const GateType type = netlist.getType(g);
+        Aig::Edge e = Aig::ZERO;
+
+        switch (type) {
+            case GateType::INPUT:
+                e = inputs[inputIndex[g]];
+                break;
+            case GateType::AND:
+            case GateType::NAND:
+                e = pin != end ? Aig::ONE : Aig::ZERO;
+                for (; pin != end; ++pin) e = aig.createAnd(e, edges[*pin]);
+                if (type == GateType::NAND) e = Aig::negate(e);
+                break;
+            case GateType::OR:
+            case GateType::NOR:
+                for (; pin != end; ++pin) e = aig.createOr(e, edges[*pin]);
+                if (type == GateType::NOR) e = Aig::negate(e);
+                break;
+            case GateType::XOR:
+                for (; pin != end; ++pin) e = aig.createXor(e, edges[*pin]);
+                break;
+            case GateType::NOT:
+                e = Aig::negate(edges[*pin]);
+                break;
+            case GateType::OUTPUT:
+                e = edges[*pin];
+                break;
+            case GateType::DFF:
+            case GateType::LATCH:
+            case GateType::CLOCK:
+                break;  // reset state
+        }
+        edges[g] = e;
+    }
+    return edges;
+}
+
+Aig::Edge lowerExpression(Aig &aig, const CompiledExpression &expression, const std::vector<Aig::Edge> &variables) {
+    using Opcode = CompiledExpression::Opcode;
+    std::vector<Aig::Edge> stack;
+    for (const CompiledExpression::Instruction &in : expression.getCode()) {
+        if (in.op == Opcode::VAR) {
+            stack.push_back(variables[in.var]);
+            continue;
+        }
+        if (in.op == Opcode::NOT) {
+            stack.back() = Aig::negate(stack.back());
+            continue;
+        }
+        Aig::Edge b = stack.back();
+        stack.pop_back();
+        Aig::Edge a = stack.back();
+        stack.back() = in.op == Opcode::AND ? aig.createAnd(a, b) : in.op == Opcode::OR ? aig.createOr(a, b) : aig.createXor(a, b);
+    }
+    return stack.empty() ? Aig::ZERO : stack.back();
+}
+
+void AigEvaluator::compile(const Netlist &netlist) {
+    aig = Aig();
+    std::vector<Aig::Edge> inputs;
+    for (size_t i = 0; i < netlist.getInputs().size(); ++i) inputs.push_back(aig.createInput());
+    std::vector<Aig::Edge> edges = lowerNetlist(aig, netlist, inputs);
+
+    inputSignals = netlist.getInputs();
+    outputs.clear();
+    for (uint32_t o : netlist.getOutputs()) outputs.push_back({o, edges[o]});
+}
+
+void AigEvaluator::evaluate(std::vector<uint64_t> &values, size_t words) const {
+    // One node buffer per thread, reused across calls
+    thread_local std::vector<uint64_t> nodeValues;
+    nodeValues.resize(aig.nodeCount() * words);
+
+    const std::vector<uint32_t> &inputs = aig.getInputs();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        std::copy_n(values.data() + size_t(inputSignals[i]) * words, words, nodeValues.data() + size_t(inputs[i]) * words);
+    }
+    aig.simulate(nodeValues.data(), words);
+
+    for (const auto &output : outputs) {
+        const uint64_t *source = nodeValues.data() + size_t(Aig::nodeOf(output.second)) * words;
+        const uint64_t mask = (output.second & 1) ? ~uint64_t(0) : 0;
+        uint64_t *d = values.data() + size_t(output.first) * words;
+        for (size_t w = 0; w < words; ++w) d[w] = source[w] ^ mask;
+    }
+}
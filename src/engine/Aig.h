@@ -0,0 +1,84 @@
+// engine/Aig.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "CircuitEvaluator.h"
+#include "Expression.h"
+#include "Netlist.h"
+
+// And-Inverter Graph: every node is a two-input AND of complementable edges, 8 bytes each.
+// Nodes are created in topological order and structurally hashed, so building the same
+// AND twice returns the first node and duplicate logic merges as it is lowered. Trivial
+// ANDs (constant, equal or opposite inputs) fold without a node.
+//
+// An edge is node << 1 | complement bit. Node 0 is constant 0, so ZERO and ONE are its
+// two polarities. Inputs are nodes with fanin0 == INPUT_MARK and fanin1 = input number.
+class Aig {
+   public:
+    using Edge = uint32_t;
+
+    static constexpr Edge ZERO = 0;
+    static constexpr Edge ONE = 1;
+    static constexpr Edge INPUT_MARK = 0xFFFFFFFFu;
+
+    struct Node {
+        Edge fanin0;
+        Edge fanin1;
+    };
+
+    Aig();
+
+    Edge createInput();
+    Edge createAnd(Edge a, Edge b);
+    Edge createOr(Edge a, Edge b) { return negate(createAnd(negate(a), negate(b))); }
+    Edge createXor(Edge a, Edge b);
+
+    static Edge negate(Edge e) { return e ^ 1; }
+    static uint32_t nodeOf(Edge e) { return e >> 1; }
+
+    size_t nodeCount() const { return nodes.size(); }
+    size_t andCount() const { return nodes.size() - 1 - inputs.size(); }
+    const Node &getNode(uint32_t node) const { return nodes[node]; }
+    bool isInput(uint32_t node) const { return node != 0 && nodes[node].fanin0 == INPUT_MARK; }
+    bool isAnd(uint32_t node) const { return node != 0 && nodes[node].fanin0 != INPUT_MARK; }
+    const std::vector<uint32_t> &getInputs() const { return inputs; }
+
+    // Bit-parallel simulation over blocks of `words` words: node n is the block at
+    // values[n * words]. Input blocks are read, node 0 and every AND block are written.
+    void simulate(uint64_t *values, size_t words) const;
+
+   private:
+    std::vector<Node> nodes;
+    std::vector<uint32_t> inputs;
+    std::vector<uint32_t> table;  // open addressing over AND nodes, 0 = empty slot
+
+    size_t slotOf(Edge a, Edge b) const;
+    void grow();
+};
+
+// Lowers every gate of a netlist, returning one edge per signal (constZero() included);
+// inputs[i] is the edge of netlist input i. Gates read like in the evaluators: unreached
+// gates and empty AND/OR/XOR are 0, NAND/NOR invert that.
+std::vector<Aig::Edge> lowerNetlist(Aig &aig, const Netlist &netlist, const std::vector<Aig::Edge> &inputs);
+
+// Lowers a compiled expression; variables[j] is the edge of variable j
+Aig::Edge lowerExpression(Aig &aig, const CompiledExpression &expression, const std::vector<Aig::Edge> &variables);
+
+// Truth table back end that simulates the strashed AIG of the netlist
+class AigEvaluator : public CircuitEvaluator {
+   public:
+    void compile(const Netlist &netlist);
+
+    const Aig &getAig() const { return aig; }
+    const char *getName() const override { return "aig"; }
+    void evaluate(std::vector<uint64_t> &values, size_t words) const override;
+
+   private:
+    Aig aig;
+    std::vector<uint32_t> inputSignals;                     // netlist signal of each AIG input
+    std::vector<std::pair<uint32_t, Aig::Edge>> outputs;  // netlist OUTPUT gate and its edge
+};
@@ -0,0 +1,453 @@
+// engine/Bdd.cpp
+
+#include "Bdd.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr size_t INITIAL_BUCKETS = size_t(1) << 12;
+constexpr size_t INITIAL_CACHE = size_t(1) << 16;
+constexpr size_t MAX_CACHE = size_t(1) << 22;
+constexpr size_t INITIAL_COLLECT_THRESHOLD = size_t(1) << 16;
+
+}  // namespace
+
+BddManager::BddManager(size_t maxNodes) : maxNodes(maxNodes), collectThreshold(std::min(INITIAL_COLLECT_THRESHOLD, maxNodes)) {
+    nodes.push_back({TERMINAL_VAR, ONE, ONE, 0, 1});
+    buckets.assign(INITIAL_BUCKETS, 0);
+    cache.assign(INITIAL_CACHE, {});
+}
+
+size_t BddManager::hashTriple(uint32_t a, uint32_t b, uint32_t c) {
+    uint64_t h = a * 0x9E3779B97F4A7C15ull;
+    h ^= (b + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+    h ^= (c + 0x165667B19E3779F9ull) * 0x94D049BB133111EBull;
+    return static_cast<size_t>(h ^ (h >> 31));
+}
+
+BddManager::Edge BddManager::variable(uint32_t var) {
+    maybeCollect(ONE, ONE, ONE);
+    Edge e = makeNode(var, ONE, ZERO);
+    if (e == INVALID) error = "BDD node limit reached (" + std::to_string(maxNodes) + " nodes)";
+    return e;
+}
+
+BddManager::Edge BddManager::ite(Edge f, Edge g, Edge h) {
+    if (f == INVALID || g == INVALID || h == INVALID) return INVALID;
+    maybeCollect(f, g, h);
+    Edge result = iteStep(f, g, h);
+    if (result == INVALID && liveNodeCount() > 1) {
+        // Retry once from a clean table before giving up
+        protect(f, g, h);
+        collectGarbage();
+        release(f, g, h);
+        result = iteStep(f, g, h);
+    }
+    if (result == INVALID) error = "BDD node limit reached (" + std::to_string(maxNodes) + " nodes)";
+    return result;
+}
+
+BddManager::Edge BddManager::cofactor(Edge e, uint32_t var, bool positive) const {
+    const Node &node = nodes[e >> 1];
+    if (node.var != var) return e;
+    return (positive ? node.high : node.low) ^ (e & 1);
+}
+
+BddManager::Edge BddManager::makeNode(uint32_t var, Edge high, Edge low) {
+    if (high == low) return high;
+
+    // Keep the high edge regular and move its complement to the result
+    const Edge negate = high & 1;
+    high ^= negate;
+    low ^= negate;
+
+    size_t bucket = hashTriple(var, high, low) & (buckets.size() - 1);
+    for (uint32_t i = buckets[bucket]; i != 0; i = nodes[i].next) {
+        const Node &node = nodes[i];
+        if (node.var == var && node.high == high && node.low == low) return (Edge(i) << 1) | negate;
+    }
+
+    if (liveNodeCount() >= maxNodes) return INVALID;
+    uint32_t index;
+    if (!freeNodes.empty()) {
+        index = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[index] = {var, high, low, buckets[bucket], 0};
+    } else {
+        index = static_cast<uint32_t>(nodes.size());
+        nodes.push_back({var, high, low, buckets[bucket], 0});
+    }
+    buckets[bucket] = index;
+
+    if (liveNodeCount() > 2 * buckets.size()) rehash(2 * buckets.size());
+    return (Edge(index) << 1) | negate;
+}
+
+BddManager::Edge BddManager::iteStep(Edge f, Edge g, Edge h) {
+    if (f == ONE) return g;
+    if (f == ZERO) return h;
+    if (g == f) {
+        g = ONE;
+    } else if (g == (f ^ 1)) {
+        g = ZERO;
+    }
+    if (h == f) {
+        h = ZERO;
+    } else if (h == (f ^ 1)) {
+        h = ONE;
+    }
+    if (g == h) return g;
+    if (g == ONE && h == ZERO) return f;
+    if (g == ZERO && h == ONE) return f ^ 1;
+
+    // Standard triple: f and g regular, with the complement moved to the result
+    if (f & 1) {
+        f ^= 1;
+        std::swap(g, h);
+    }
+    const Edge negate = g & 1;
+    g ^= negate;
+    h ^= negate;
+
+    CacheEntry &entry = cache[hashTriple(f, g, h) & (cache.size() - 1)];
+    if (entry.f == f && entry.g == g && entry.h == h) return entry.result ^ negate;
+
+    const uint32_t var = std::min({varOf(f), varOf(g), varOf(h)});
+    Edge high = iteStep(cofactor(f, var, true), cofactor(g, var, true), cofactor(h, var, true));
+    if (high == INVALID) return INVALID;
+    Edge low = iteStep(cofactor(f, var, false), cofactor(g, var, false), cofactor(h, var, false));
+    if (low == INVALID) return INVALID;
+    Edge result = makeNode(var, high, low);
+    if (result == INVALID) return INVALID;
+
+    // The recursion may have resized the cache
+    CacheEntry &slot = cache[hashTriple(f, g, h) & (cache.size() - 1)];
+    slot = {f, g, h, result};
+    return result ^ negate;
+}
+
+void BddManager::ref(Edge e) {
+    if (e != INVALID) ++nodes[e >> 1].refs;
+}
+
+void BddManager::deref(Edge e) {
+    if (e != INVALID && nodes[e >> 1].refs > 0) --nodes[e >> 1].refs;
+}
+
+void BddManager::maybeCollect(Edge f, Edge g, Edge h) {
+    if (liveNodeCount() < collectThreshold) return;
+    protect(f, g, h);
+    collectGarbage();
+    release(f, g, h);
+}
+
+void BddManager::protect(Edge f, Edge g, Edge h) {
+    ref(f);
+    ref(g);
+    ref(h);
+}
+
+void BddManager::release(Edge f, Edge g, Edge h) {
+    deref(f);
+    deref(g);
+    deref(h);
+}
+
+void BddManager::collectGarbage() {
+    std::vector<uint8_t> marked(nodes.size(), 0);
+    std::vector<uint32_t> stack;
+    marked[0] = 1;
+    for (uint32_t i = 1; i < nodes.size(); ++i) {
+        if (nodes[i].refs > 0 && nodes[i].var != FREE_VAR) stack.push_back(i);
+    }
+    while (!stack.empty()) {
+        uint32_t i = stack.back();
+        stack.pop_back();
+        if (marked[i]) continue;
+        marked[i] = 1;
+        stack.push_back(nodes[i].high >> 1);
+        stack.push_back(nodes[i].low >> 1);
+    }
+
+    for (uint32_t i = 1; i < nodes.size(); ++i) {
+        if (marked[i] || nodes[i].var == FREE_VAR) continue;
+        nodes[i].var = FREE_VAR;
+        freeNodes.push_back(i);
+    }
+
+    // Cached results may name freed nodes
+    std::fill(cache.begin(), cache.end(), CacheEntry{});
+    rehash(buckets.size());
+    collectThreshold = std::min(maxNodes, std::max(INITIAL_COLLECT_THRESHOLD, 2 * liveNodeCount()));
+}
+
+void BddManager::rehash(size_t bucketCount) {
+    buckets.assign(bucketCount, 0);
+    for (uint32_t i = 1; i < nodes.size(); ++i) {
+        Node &node = nodes[i];
+        if (node.var == FREE_VAR) continue;
+        size_t bucket = hashTriple(node.var, node.high, node.low) & (bucketCount - 1);
+        node.next = buckets[bucket];
+        buckets[bucket] = i;
+    }
+    if (cache.size() < std::min(bucketCount, MAX_CACHE)) cache.assign(std::min(bucketCount, MAX_CACHE), {});
+}
+
+double BddManager::satCount(Edge f, uint32_t varCount) const {
+    // Fraction of assignments that reach ONE, per node; a complement edge takes 1 - fraction
+    std::vector<double> fraction(nodes.size(), -1.0);
+    fraction[0] = 1.0;
+    std::vector<uint32_t> stack{f >> 1};
+    while (!stack.empty()) {
+        uint32_t i = stack.back();
+        const Node &node = nodes[i];
+        double high = fraction[node.high >> 1];
+        double low = fraction[node.low >> 1];
+        if (high < 0 || low < 0) {
+            if (high < 0) stack.push_back(node.high >> 1);
+            if (low < 0) stack.push_back(node.low >> 1);
+            continue;
+        }
+        stack.pop_back();
+        if (node.low & 1) low = 1.0 - low;
+        fraction[i] = (high + low) / 2;
+    }
+    double result = fraction[f >> 1];
+    if (f & 1) result = 1.0 - result;
+    return std::ldexp(result, static_cast<int>(varCount));
+}
+
+bool BddManager::satisfyingAssignment(Edge f, std::vector<int8_t> &values) const {
+    std::fill(values.begin(), values.end(), -1);
+    if (f == ZERO) return false;
+
+    // In a reduced graph every edge other than ZERO leads to a satisfying path
+    for (Edge e = f; (e >> 1) != 0;) {
+        const Node &node = nodes[e >> 1];
+        if (values.size() <= node.var) values.resize(node.var + 1, -1);
+        Edge high = node.high ^ (e & 1);
+        Edge low = node.low ^ (e & 1);
+        values[node.var] = high != ZERO ? 1 : 0;
+        e = high != ZERO ? high : low;
+    }
+    return true;
+}
+
+size_t BddManager::nodeCount(Edge f) const {
+    std::vector<uint8_t> visited(nodes.size(), 0);
+    std::vector<uint32_t> stack{f >> 1};
+    size_t count = 0;
+    while (!stack.empty()) {
+        uint32_t i = stack.back();
+        stack.pop_back();
+        if (visited[i]) continue;
+        visited[i] = 1;
+        ++count;
+        if (i != 0) {
+            stack.push_back(nodes[i].high >> 1);
+            stack.push_back(nodes[i].low >> 1);
+        }
+    }
+    return count;
+}
+
+bool BddManager::isop(Edge f, uint32_t varCount, std::vector<Cube> &cover) {
+    cover.clear();
+    if (varCount > 64) {
+        error = "Too many variables for a cube cover (" + std::to_string(varCount) + ")";
+        return false;
+    }
+    if (f == INVALID) return false;
+
+    maybeCollect(f, f, f);
+    const uint64_t allVars = varCount >= 64 ? ~uint64_t(0) : (uint64_t(1) << varCount) - 1;
+    if (isopStep(f, f, {0, allVars}, cover) == INVALID) {
+        error = "BDD node limit reached (" + std::to_string(maxNodes) + " nodes)";
+        cover.clear();
+        return false;
+    }
+    return true;
+}
+
+BddManager::Edge BddManager::isopStep(Edge lower, Edge upper, Cube cube, std::vector<Cube> &cover) {
+    // Cover of some function between lower and upper; returns that function
+    if (lower == ZERO) return ZERO;
+    if (upper == ONE) {
+        cover.push_back(cube);
+        return ONE;
+    }
+
+    const uint32_t var = std::min(varOf(lower), varOf(upper));
+    const uint64_t bit = uint64_t(1) << var;
+    const Edge lower0 = cofactor(lower, var, false), lower1 = cofactor(lower, var, true);
+    const Edge upper0 = cofactor(upper, var, false), upper1 = cofactor(upper, var, true);
+
+    // Rows that need the literal ~var, then var
+    Edge onlyLow = iteStep(lower0, upper1 ^ 1, ZERO);
+    if (onlyLow == INVALID) return INVALID;
+    Edge low = isopStep(onlyLow, upper0, {cube.value, cube.mask & ~bit}, cover);
+    if (low == INVALID) return INVALID;
+    Edge onlyHigh = iteStep(lower1, upper0 ^ 1, ZERO);
+    if (onlyHigh == INVALID) return INVALID;
+    Edge high = isopStep(onlyHigh, upper1, {cube.value | bit, cube.mask & ~bit}, cover);
+    if (high == INVALID) return INVALID;
+
+    // What is left is covered without the variable
+    Edge rest0 = iteStep(lower0, low ^ 1, ZERO);
+    Edge rest1 = rest0 == INVALID ? INVALID : iteStep(lower1, high ^ 1, ZERO);
+    Edge rest = rest1 == INVALID ? INVALID : iteStep(rest0, ONE, rest1);
+    Edge both = rest == INVALID ? INVALID : iteStep(upper0, upper1, ZERO);
+    if (both == INVALID) return INVALID;
+    Edge shared = isopStep(rest, both, cube, cover);
+    if (shared == INVALID) return INVALID;
+
+    Edge split = makeNode(var, high, low);
+    return split == INVALID ? INVALID : iteStep(split, ONE, shared);
+}
+
+bool buildNetlistBdds(BddManager &manager, const Netlist &netlist, const std::vector<uint32_t> &variableOf,
+                      std::vector<BddManager::Edge> &outputs) {
+    using Edge = BddManager::Edge;
+    outputs.clear();
+
+    // Gates stay referenced until their last reader has been built
+    std::vector<Edge> values(netlist.signalCount(), BddManager::ZERO);
+    std::vector<uint32_t> readers(netlist.signalCount(), 0);
+    std::vector<uint8_t> held(netlist.signalCount(), 0);
+    for (uint32_t g : netlist.getOrder()) {
+        for (const uint32_t *pin = netlist.faninBegin(g); pin != netlist.faninEnd(g); ++pin) ++readers[*pin];
+    }
+    std::vector<uint32_t> inputIndex(netlist.gateCount(), 0);
+    for (size_t i = 0; i < netlist.getInputs().size(); ++i) inputIndex[netlist.getInputs()[i]] = static_cast<uint32_t>(i);
+
+    auto release = [&]() {
+        for (size_t s = 0; s < held.size(); ++s) {
+            if (held[s]) manager.deref(values[s]);
+        }
+    };
+
+    for (uint32_t g : netlist.getOrder()) {
+        const uint32_t *pin = netlist.faninBegin(g);
+        const uint32_t *end = netlist.faninEnd(g);
+        const GateType type = netlist.getType(g);
+        Edge v = BddManager::ZERO;
+
+        switch (type) {
+            case GateType::INPUT:
+                v = manager.variable(variableOf[inputIndex[g]]);
+                break;
+            case GateType::AND:
+            case GateType::NAND:
+                v = pin != end ? BddManager::ONE : BddManager::ZERO;
+                for (; pin != end && v != BddManager::INVALID; ++pin) v = manager.bddAnd(v, values[*pin]);
+                if (type == GateType::NAND) v = BddManager::bddNot(v);
+                break;
+            case GateType::OR:
+            case GateType::NOR:
+                for (; pin != end && v != BddManager::INVALID; ++pin) v = manager.bddOr(v, values[*pin]);
+                if (type == GateType::NOR) v = BddManager::bddNot(v);
+                break;
+            case GateType::XOR:
+                for (; pin != end && v != BddManager::INVALID; ++pin) v = manager.bddXor(v, values[*pin]);
+                break;
+            case GateType::NOT:
+                v = BddManager::bddNot(values[*pin]);
+                break;
+            case GateType::OUTPUT:
+                v = values[*pin];
+                break;
+            case GateType::DFF:
+            case GateType::LATCH:
+            case GateType::CLOCK:
+                break;  // reset state
+        }
+        if (v == BddManager::INVALID) {
+            release();
+            return false;
+        }
+
+        values[g] = v;
+        manager.ref(v);
+        held[g] = 1;
+        for (pin = netlist.faninBegin(g); pin != end; ++pin) {
+            if (--readers[*pin] == 0 && held[*pin]) {
+                manager.deref(values[*pin]);
+                held[*pin] = 0;
+            }
+        }
+    }
+
+    for (uint32_t o : netlist.getOutputs()) {
+        outputs.push_back(values[o]);
+        manager.ref(values[o]);
+    }
+    release();
+    return true;
+}
+
+std::vector<uint32_t> netlistVariableOrder(const Netlist &netlist) {
+    const std::vector<uint32_t> &inputs = netlist.getInputs();
+    std::vector<uint32_t> inputIndex(netlist.gateCount(), 0);
+    for (size_t i = 0; i < inputs.size(); ++i) inputIndex[inputs[i]] = static_cast<uint32_t>(i);
+
+    const uint32_t unassigned = 0xFFFFFFFFu;
+    std::vector<uint32_t> variableOf(inputs.size(), unassigned);
+    uint32_t next = 0;
+    std::vector<uint8_t> visited(netlist.signalCount(), 0);
+    std::vector<uint32_t> stack;
+    for (uint32_t o : netlist.getOutputs()) {
+        stack.push_back(o);
+        while (!stack.empty()) {
+            uint32_t g = stack.back();
+            stack.pop_back();
+            if (g == netlist.constZero() || visited[g]) continue;
+            visited[g] = 1;
+            if (netlist.getType(g) == GateType::INPUT) {
+                variableOf[inputIndex[g]] = next++;
+                continue;
+            }
+            if (Gate::isSource(netlist.getType(g))) continue;
+            // Reversed so the first pin is explored first
+            for (const uint32_t *pin = netlist.faninEnd(g); pin != netlist.faninBegin(g);) stack.push_back(*--pin);
+        }
+    }
+    for (uint32_t &var : variableOf) {
+        if (var == unassigned) var = next++;
+    }
+    return variableOf;
+}
+
+BddManager::Edge buildExpressionBdd(BddManager &manager, const CompiledExpression &expression, const std::vector<uint32_t> &variableOf) {
+    using Edge = BddManager::Edge;
+    using Opcode = CompiledExpression::Opcode;
+
+    // Every stack entry holds a reference, since collection may run between operations
+    std::vector<Edge> stack;
+    for (const CompiledExpression::Instruction &in : expression.getCode()) {
+        Edge result;
+        if (in.op == Opcode::VAR) {
+            result = manager.variable(variableOf[in.var]);
+        } else if (in.op == Opcode::NOT) {
+            result = BddManager::bddNot(stack.back());
+            manager.deref(stack.back());
+            stack.pop_back();
+        } else {
+            Edge b = stack.back();
+            stack.pop_back();
+            Edge a = stack.back();
+            stack.pop_back();
+            result = in.op == Opcode::AND ? manager.bddAnd(a, b) : in.op == Opcode::OR ? manager.bddOr(a, b) : manager.bddXor(a, b);
+            manager.deref(a);
+            manager.deref(b);
+        }
+        if (result == BddManager::INVALID) {
+            for (Edge e : stack) manager.deref(e);
+            return BddManager::INVALID;
+        }
+        manager.ref(result);
+        stack.push_back(result);
+    }
+    return stack.empty() ? BddManager::INVALID : stack.back();
+}
@@ -0,0 +1,114 @@
+// engine/Bdd.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Expression.h"
+#include "Minimizer.h"
+#include "Netlist.h"
+
+// Reduced ordered BDDs with complement edges. Nodes are hash-consed in a unique table,
+// so two functions are equal exactly when their edges are equal, and ite() results are
+// memoized in a lossy computed table. Variable v sits at level v (smaller is closer to
+// the root).
+//
+// An edge is node index << 1 | complement bit. Node 0 is the terminal, so ONE and ZERO
+// are its two polarities. High edges are always regular, which keeps the form canonical.
+//
+// Garbage collection only runs on entry to the public operations: edges the caller wants
+// to keep across calls must be protected with ref(). Operations return INVALID once the
+// node limit is reached even after collecting; getError() then says so.
+class BddManager {
+   public:
+    using Edge = uint32_t;
+
+    static constexpr Edge ONE = 0;
+    static constexpr Edge ZERO = 1;
+    static constexpr Edge INVALID = 0xFFFFFFFFu;
+    static constexpr size_t DEFAULT_MAX_NODES = size_t(1) << 22;
+
+    explicit BddManager(size_t maxNodes = DEFAULT_MAX_NODES);
+
+    Edge variable(uint32_t var);
+    Edge ite(Edge f, Edge g, Edge h);
+    Edge bddAnd(Edge a, Edge b) { return ite(a, b, ZERO); }
+    Edge bddOr(Edge a, Edge b) { return ite(a, ONE, b); }
+    Edge bddXor(Edge a, Edge b) { return b == INVALID ? INVALID : ite(a, b ^ 1, b); }
+    static Edge bddNot(Edge e) { return e == INVALID ? INVALID : e ^ 1; }
+
+    // External references; referenced nodes and everything below them survive collection
+    void ref(Edge e);
+    void deref(Edge e);
+    void collectGarbage();
+
+    // Number of assignments to variables 0..varCount-1 that make f true
+    double satCount(Edge f, uint32_t varCount) const;
+
+    // One satisfying assignment: values[v] is 0 or 1 on the chosen path, -1 elsewhere.
+    // Returns false if f is ZERO.
+    bool satisfyingAssignment(Edge f, std::vector<int8_t> &values) const;
+
+    // Nodes reachable from f, terminal included
+    size_t nodeCount(Edge f) const;
+    size_t liveNodeCount() const { return nodes.size() - freeNodes.size(); }
+
+    // Irredundant sum-of-products cover of f (Minato-Morreale), computed on the graph
+    // without enumerating rows. Cube bit v is variable v, so varCount must be at most 64.
+    bool isop(Edge f, uint32_t varCount, std::vector<Cube> &cover);
+
+    const std::string &getError() const { return error; }
+
+   private:
+    static constexpr uint32_t TERMINAL_VAR = 0xFFFFFFFFu;
+    static constexpr uint32_t FREE_VAR = 0xFFFFFFFEu;
+
+    struct Node {
+        uint32_t var;
+        Edge high;  // always regular
+        Edge low;
+        uint32_t next;  // unique table chain, 0 ends it
+        uint32_t refs;
+    };
+
+    struct CacheEntry {
+        Edge f = INVALID, g = INVALID, h = INVALID;
+        Edge result = INVALID;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> freeNodes;
+    std::vector<uint32_t> buckets;
+    std::vector<CacheEntry> cache;
+    size_t maxNodes;
+    size_t collectThreshold;
+    std::string error;
+
+    uint32_t varOf(Edge e) const { return nodes[e >> 1].var; }
+    Edge cofactor(Edge e, uint32_t var, bool positive) const;
+    Edge makeNode(uint32_t var, Edge high, Edge low);
+    Edge iteStep(Edge f, Edge g, Edge h);
+    Edge isopStep(Edge lower, Edge upper, Cube cube, std::vector<Cube> &cover);
+    void maybeCollect(Edge f, Edge g, Edge h);
+    void protect(Edge f, Edge g, Edge h);
+    void release(Edge f, Edge g, Edge h);
+    void rehash(size_t bucketCount);
+    static size_t hashTriple(uint32_t a, uint32_t b, uint32_t c);
+};
+
+// BDDs for every netlist output in getOutputs() order. variableOf[i] is the BDD variable
+// of netlist input i. The returned edges are referenced; unreached gates read 0 as in the
+// evaluators. Returns false if the manager ran out of nodes.
+bool buildNetlistBdds(BddManager &manager, const Netlist &netlist, const std::vector<uint32_t> &variableOf,
+                      std::vector<BddManager::Edge> &outputs);
+
+// Variable for each netlist input, in the order inputs are first reached by a depth-first
+// walk from the outputs. Inputs that feed the same gates end up adjacent, which keeps
+// BDDs of structured circuits small.
+std::vector<uint32_t> netlistVariableOrder(const Netlist &netlist);
+
+// BDD of a compiled expression; variableOf[j] is the BDD variable of expression variable j.
+// The returned edge is referenced. INVALID if the manager ran out of nodes.
+BddManager::Edge buildExpressionBdd(BddManager &manager, const CompiledExpression &expression, const std::vector<uint32_t> &variableOf);
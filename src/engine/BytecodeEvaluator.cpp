@@ -0,0 +1,218 @@
+// engine/BytecodeEvaluator.cpp
+
+#include "BytecodeEvaluator.h"
+
+#include <algorithm>
+
+namespace {
+
+const uint32_t NO_REGISTER = 0xFFFFFFFFu;
+const uint32_t NO_USE = 0xFFFFFFFFu;
+
+BytecodeEvaluator::Instruction memoryAccess(BytecodeEvaluator::Opcode op, uint32_t reg, uint32_t signal) {
+    return {op, static_cast<uint16_t>(reg), static_cast<uint16_t>(signal & 0xFFFF), static_cast<uint16_t>(signal >> 16)};
+}
+
+BytecodeEvaluator::Instruction operation(BytecodeEvaluator::Opcode op, uint32_t dst, uint32_t a, uint32_t b) {
+    return {op, static_cast<uint16_t>(dst), static_cast<uint16_t>(a), static_cast<uint16_t>(b)};
+}
+
+}  // namespace
+
+bool BytecodeEvaluator::compile(const Netlist &netlist, bool storeAllGates) {
+    const auto &order = netlist.getOrder();
+    const uint32_t zero = netlist.constZero();
+    code.clear();
+    code.reserve(order.size() * 2 + netlist.getInputs().size() + 1);
+
+    // Position in order of the last gate reading each signal
+    std::vector<uint32_t> lastUse(netlist.signalCount(), NO_USE);
+    for (uint32_t pos = 0; pos < order.size(); ++pos) {
+        for (const uint32_t *pin = netlist.faninBegin(order[pos]); pin != netlist.faninEnd(order[pos]); ++pin) lastUse[*pin] = pos;
+    }
+
+    std::vector<uint32_t> regOf(netlist.signalCount(), NO_REGISTER);
+    std::vector<uint32_t> freeRegisters;
+    regOf[zero] = ZERO_REGISTER;
+    registers = 1;
+
+    // Live simulation loads clocks and registers like inputs; for truth tables they hold their reset state
+    if (!storeAllGates) {
+        for (uint32_t g : netlist.getClocks()) regOf[g] = ZERO_REGISTER;
+        for (uint32_t g : netlist.getRegisters()) regOf[g] = ZERO_REGISTER;
+    }
+
+    auto allocate = [&]() {
+        if (freeRegisters.empty()) return static_cast<uint32_t>(registers++);
+        uint32_t r = freeRegisters.back();
+        freeRegisters.pop_back();
+        return r;
+    };
+    auto release = [&](uint32_t signal) {
+        if (regOf[signal] == NO_REGISTER || regOf[signal] == ZERO_REGISTER) return;
+        freeRegisters.push_back(regOf[signal]);
+        regOf[signal] = NO_REGISTER;
+    };
+
+    code.push_back(operation(Opcode::ZERO, ZERO_REGISTER, 0, 0));
+
+    std::vector<uint32_t> operands;
+    for (uint32_t pos = 0; pos < order.size(); ++pos) {
+        const uint32_t g = order[pos];
+        const GateType type = netlist.getType(g);
+        if (Gate::isSource(type)) continue;
+
+        // Inputs are loaded on first use so they only occupy a register while needed
+        operands.clear();
+        for (const uint32_t *pin = netlist.faninBegin(g); pin != netlist.faninEnd(g); ++pin) {
+            if (regOf[*pin] == NO_REGISTER) {
+                regOf[*pin] = allocate();
+                code.push_back(memoryAccess(Opcode::LOAD, regOf[*pin], *pin));
+            }
+            operands.push_back(regOf[*pin]);
+        }
+        auto releaseOperands = [&]() {
+            for (const uint32_t *pin = netlist.faninBegin(g); pin != netlist.faninEnd(g); ++pin) {
+                if (lastUse[*pin] == pos) release(*pin);
+            }
+        };
+
+        const bool store = storeAllGates || type == GateType::OUTPUT;
+        const bool used = lastUse[g] != NO_USE;
+
+        // An output nobody reads is stored straight from its driver
+        if (type == GateType::OUTPUT && !used) {
+            code.push_back(memoryAccess(Opcode::STORE, operands.empty() ? ZERO_REGISTER : operands[0], g));
+            releaseOperands();
+            continue;
+        }
+
+        Opcode base = Opcode::COPY;
+        bool invert = false;
+        switch (type) {
+            case GateType::AND:
+                base = Opcode::AND;
+                break;
+            case GateType::NAND:
+                base = Opcode::AND;
+                invert = true;
+                break;
+            case GateType::OR:
+                base = Opcode::OR;
+                break;
+            case GateType::NOR:
+                base = Opcode::OR;
+                invert = true;
+                break;
+            case GateType::XOR:
+                base = Opcode::XOR;
+                break;
+            case GateType::NOT:
+                invert = true;
+                break;
+            case GateType::INPUT:
+            case GateType::OUTPUT:
+            case GateType::DFF:
+            case GateType::LATCH:
+            case GateType::CLOCK:
+                break;
+        }
+
+        // A chain overwrites dst while later operands are still needed, so it must not share
+        // a register with them; a single instruction reads before it writes
+        uint32_t dst;
+        if (operands.size() > 2) {
+            dst = allocate();
+            releaseOperands();
+        } else {
+            releaseOperands();
+            dst = allocate();
+        }
+        regOf[g] = dst;
+
+        if (operands.empty()) {
+            code.push_back(operation(invert ? Opcode::ONE : Opcode::ZERO, dst, 0, 0));
+        } else if (operands.size() == 1 || base == Opcode::COPY) {
+            code.push_back(operation(invert ? Opcode::NOT : Opcode::COPY, dst, operands[0], 0));
+        } else {
+            const Opcode inverted = base == Opcode::AND ? Opcode::NAND : base == Opcode::OR ? Opcode::NOR : Opcode::XNOR;
+            uint32_t acc = operands[0];
+            for (size_t i = 1; i < operands.size(); ++i) {
+                code.push_back(operation(invert && i + 1 == operands.size() ? inverted : base, dst, acc, operands[i]));
+                acc = dst;
+            }
+        }
+
+        if (store) code.push_back(memoryAccess(Opcode::STORE, dst, g));
+        if (!used) release(g);
+    }
+
+    // Gates behind a cycle are never evaluated and read as 0
+    for (uint32_t g = 0; g < netlist.gateCount(); ++g) {
+        if (netlist.getLevel(g) == Netlist::UNREACHED && (storeAllGates || netlist.getType(g) == GateType::OUTPUT)) {
+            code.push_back(memoryAccess(Opcode::STORE, ZERO_REGISTER, g));
+        }
+    }
+    if (storeAllGates) code.push_back(memoryAccess(Opcode::STORE, ZERO_REGISTER, zero));
+
+    if (registers > MAX_REGISTERS) {
+        code.clear();
+        registers = 1;
+        return false;
+    }
+    return true;
+}
+
+void BytecodeEvaluator::evaluate(std::vector<uint64_t> &values, size_t words) const {
+    // One register file per thread, reused across calls
+    thread_local std::vector<uint64_t> registerFile;
+    registerFile.resize(registers * words);
+    run(values.data(), registerFile.data(), words);
+}
+
+void BytecodeEvaluator::run(uint64_t *values, uint64_t *registerFile, size_t words) const {
+    // Registers are blocks of `words` words like the signals, so dispatch is paid once per block
+    for (const Instruction &in : code) {
+        uint64_t *d = registerFile + in.dst * words;
+        const uint64_t *a = registerFile + in.a * words;
+        const uint64_t *b = registerFile + in.b * words;
+        switch (in.op) {
+            case Opcode::LOAD:
+                std::copy_n(values + (in.a | size_t(in.b) << 16) * words, words, d);
+                break;
+            case Opcode::STORE:
+                std::copy_n(d, words, values + (in.a | size_t(in.b) << 16) * words);
+                break;
+            case Opcode::ZERO:
+                std::fill_n(d, words, uint64_t(0));
+                break;
+            case Opcode::ONE:
+                std::fill_n(d, words, ~uint64_t(0));
+                break;
+            case Opcode::COPY:
+                std::copy_n(a, words, d);
+                break;
+            case Opcode::NOT:
+                for (size_t w = 0; w < words; ++w) d[w] = ~a[w];
+                break;
+            case Opcode::AND:
+                for (size_t w = 0; w < words; ++w) d[w] = a[w] & b[w];
+                break;
+            case Opcode::OR:
+                for (size_t w = 0; w < words; ++w) d[w] = a[w] | b[w];
+                break;
+            case Opcode::XOR:
+                for (size_t w = 0; w < words; ++w) d[w] = a[w] ^ b[w];
+                break;
+            case Opcode::NAND:
+                for (size_t w = 0; w < words; ++w) d[w] = ~(a[w] & b[w]);
+                break;
+            case Opcode::NOR:
+                for (size_t w = 0; w < words; ++w) d[w] = ~(a[w] | b[w]);
+                break;
+            case Opcode::XNOR:
+                for (size_t w = 0; w < words; ++w) d[w] = ~(a[w] ^ b[w]);
+                break;
+        }
+    }
+}
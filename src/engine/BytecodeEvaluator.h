@@ -0,0 +1,46 @@
+// engine/BytecodeEvaluator.h
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "CircuitEvaluator.h"
+
+// Register-based bytecode for a compiled netlist. Every gate in level order becomes one
+// instruction over a flat register file (n-ary gates become a short chain); registers are
+// recycled as soon as the last reader of a value has run, so the register file stays about
+// as wide as the circuit rather than as large. Needs no compiler toolchain at runtime.
+class BytecodeEvaluator : public CircuitEvaluator {
+   public:
+    enum class Opcode : uint8_t { LOAD, STORE, ZERO, ONE, COPY, NOT, AND, OR, XOR, NAND, NOR, XNOR };
+
+    // 8 bytes, so a few thousand gates stay within L1. LOAD/STORE address signal a | b << 16:
+    // LOAD: r[dst] = values[signal]   STORE: values[signal] = r[dst]   other: r[dst] = r[a] op r[b]
+    struct Instruction {
+        Opcode op;
+        uint16_t dst;
+        uint16_t a;
+        uint16_t b;
+    };
+
+    static constexpr uint16_t ZERO_REGISTER = 0;  // holds 0 for unconnected pins
+    static constexpr size_t MAX_REGISTERS = 0x10000;
+
+    // storeAllGates: write every gate's value back (live simulation); otherwise only OUTPUT
+    // gates are stored, which is all truth table generation reads. Returns false if the
+    // circuit is too wide for 16-bit register numbers.
+    bool compile(const Netlist &netlist, bool storeAllGates);
+
+    const std::vector<Instruction> &getCode() const { return code; }
+    size_t registerCount() const { return registers; }
+
+    const char *getName() const override { return "bytecode"; }
+    void evaluate(std::vector<uint64_t> &values, size_t words) const override;
+
+    // Runs the program with a caller-owned register file of registerCount() * words words
+    void run(uint64_t *values, uint64_t *registerFile, size_t words) const;
+
+   private:
+    std::vector<Instruction> code;
+    size_t registers = 1;
+};
@@ -0,0 +1,30 @@
+// engine/CircuitEvaluator.h
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Netlist.h"
+
+// Common interface of the pattern-parallel evaluation back ends. values uses the
+// Netlist::evaluatePatterns() layout: signal s is the block of `words` uint64_t at
+// values[s * words]; INPUT blocks are read and OUTPUT blocks are written. Other gate
+// blocks may be written too, but callers must not rely on them.
+// evaluate() must be safe to call from several threads with separate values.
+class CircuitEvaluator {
+   public:
+    virtual ~CircuitEvaluator() = default;
+    virtual const char *getName() const = 0;
+    virtual void evaluate(std::vector<uint64_t> &values, size_t words) const = 0;
+};
+
+// The netlist interpreter with the SIMD pattern kernels
+class InterpretedEvaluator : public CircuitEvaluator {
+   private:
+    const Netlist &netlist;
+
+   public:
+    explicit InterpretedEvaluator(const Netlist &netlist) : netlist(netlist) {}
+    const char *getName() const override { return "interpreter"; }
+    void evaluate(std::vector<uint64_t> &values, size_t words) const override { netlist.evaluatePatterns(values, words); }
+};
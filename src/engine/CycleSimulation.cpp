@@ -0,0 +1,76 @@
+// engine/CycleSimulation.cpp
+
+#include "CycleSimulation.h"
+
+#include <algorithm>
+
+CycleSimulation::CycleSimulation(const Netlist &netlist) : netlist(netlist) {
+    program.reserve(netlist.getOrder().size());
+    for (uint32_t g : netlist.getOrder()) {
+        const GateType type = netlist.getType(g);
+        if (Gate::isSource(type)) continue;
+        const uint32_t *pin = netlist.faninBegin(g);
+        const uint32_t *end = netlist.faninEnd(g);
+        const uint32_t in0 = pin != end ? pin[0] : netlist.constZero();
+        program.push_back({g, in0, end - pin > 1 ? pin[1] : in0, Netlist::truthTable(type)});
+    }
+
+    registers.reserve(netlist.getRegisters().size());
+    for (uint32_t g : netlist.getRegisters()) {
+        const uint32_t *pin = netlist.faninBegin(g);
+        registers.push_back({g, pin[0], pin[1], netlist.getType(g) == GateType::LATCH, 0});
+    }
+    writes.reserve(registers.size());
+    values.assign(netlist.signalCount(), 0);
+}
+
+CycleState CycleSimulation::reset(const std::vector<uint8_t> &state) {
+    std::copy_n(state.begin(), std::min(state.size(), values.size()), values.begin());
+    values[netlist.constZero()] = 0;
+    edges = 0;
+    CycleState result = evaluateLogic();
+    for (Register &r : registers) r.lastClock = values[r.control];
+    return std::max(result, settle());
+}
+
+CycleState CycleSimulation::evaluateLogic() {
+    uint8_t *v = values.data();
+    for (const Instruction &in : program) v[in.gate] = (in.truth >> (v[in.in0] * 2 + v[in.in1])) & 1;
+    return netlist.hasCycles() ? netlist.solveCycles(values) : CycleState::STABLE;
+}
+
+bool CycleSimulation::updateRegisters() {
+    // Next values all come from the current state before any register is written
+    const uint8_t *v = values.data();
+    writes.clear();
+    for (Register &r : registers) {
+        const uint8_t control = v[r.control];
+        const bool load = r.latch ? control : control && !r.lastClock;
+        if (!r.latch) r.lastClock = control;
+        if (load && v[r.d] != v[r.gate]) writes.push_back({r.gate, v[r.d]});
+    }
+    for (const Write &w : writes) values[w.gate] = w.value;
+    return !writes.empty();
+}
+
+CycleState CycleSimulation::settle() {
+    CycleState worst = CycleState::STABLE;
+    for (size_t pass = 0; pass <= MAX_REGISTER_PASSES; ++pass) {
+        // The first pass always evaluates, as sources may have been changed from outside
+        if (!updateRegisters() && pass > 0) return worst;
+        worst = std::max(worst, evaluateLogic());
+    }
+    return CycleState::UNRESOLVED;
+}
+
+CycleState CycleSimulation::edge() {
+    for (uint32_t c : netlist.getClocks()) values[c] ^= 1;
+    ++edges;
+    return settle();
+}
+
+CycleState CycleSimulation::run(uint64_t cycles) {
+    CycleState worst = CycleState::STABLE;
+    for (uint64_t c = 0; c < 2 * cycles; ++c) worst = std::max(worst, edge());
+    return worst;
+}
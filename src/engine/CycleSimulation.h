@@ -0,0 +1,79 @@
+// engine/CycleSimulation.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Netlist.h"
+
+// Cycle-based simulation of circuits with DFF, LATCH and CLOCK gates. The combinational
+// logic is compiled into one flat instruction per levelized gate, each a 4-entry truth
+// table lookup, and evaluated once per clock edge with the clocks and register outputs
+// held as sources. Registers are double-buffered: every register picks its next value
+// from the settled state before any of them is written, so shift registers and counters
+// move one stage per edge.
+//
+// A DFF takes D when its CLK pin goes from 0 to 1 and a LATCH follows D while EN is 1.
+// Flip-flops clocked straight from a CLOCK or INPUT gate see the edge before the logic
+// is evaluated; clocks derived by logic or by other registers (ripple counters), and
+// latches, are handled by further passes that stop once no register changes.
+class CycleSimulation {
+   public:
+    static constexpr size_t MAX_REGISTER_PASSES = Netlist::MAX_LOOP_SWEEPS;  // per settle before giving up
+
+    explicit CycleSimulation(const Netlist &netlist);
+
+    // Takes the INPUT, CLOCK and register values from `values`, evaluates the logic and
+    // remembers the clock level every flip-flop sees, so loading a state is not an edge
+    CycleState reset(const std::vector<uint8_t> &values);
+
+    // Changes an INPUT or CLOCK gate; settle() lets the circuit react
+    void setSource(uint32_t gate, bool value) { values[gate] = value; }
+
+    // Updates the registers and evaluates the logic until no register changes, returning
+    // UNRESOLVED after MAX_REGISTER_PASSES (e.g. a transparent latch feeding its own D
+    // through an inverter) and otherwise the state of the combinational loops
+    CycleState settle();
+
+    // One clock edge: every CLOCK gate toggles and the circuit settles
+    CycleState edge();
+
+    // Full clock cycles, each a rising and a falling edge; returns the worst state seen
+    CycleState run(uint64_t cycles);
+
+    uint64_t edgeCount() const { return edges; }
+    uint8_t value(uint32_t gate) const { return values[gate]; }
+    const std::vector<uint8_t> &getValues() const { return values; }
+
+   private:
+    struct Instruction {
+        uint32_t gate;
+        uint32_t in0;
+        uint32_t in1;
+        uint8_t truth;  // bit in0 * 2 + in1 is the output, as in Netlist::truthTable()
+    };
+
+    struct Register {
+        uint32_t gate;
+        uint32_t d;
+        uint32_t control;  // CLK of a DFF, EN of a LATCH
+        uint8_t latch;
+        uint8_t lastClock;  // control level a DFF saw when the circuit last settled
+    };
+
+    struct Write {
+        uint32_t gate;
+        uint8_t value;
+    };
+
+    const Netlist &netlist;
+    std::vector<Instruction> program;
+    std::vector<Register> registers;
+    std::vector<Write> writes;
+    std::vector<uint8_t> values;
+    uint64_t edges = 0;
+
+    CycleState evaluateLogic();
+    bool updateRegisters();
+};
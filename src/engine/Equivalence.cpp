@@ -0,0 +1,108 @@
+// engine/Equivalence.cpp
+
+#include "Equivalence.h"
+
+#include <algorithm>
+
+namespace {
+
+// Asks for a vector where at least one pair differs and reads the first differing pair.
+// A miter that strashing already folded to 0 is proved without calling the solver.
+EquivalenceCheck solveMiter(Aig &aig, const std::vector<Aig::Edge> &inputs, const std::vector<std::pair<Aig::Edge, Aig::Edge>> &pairs,
+                            std::chrono::milliseconds budget) {
+    EquivalenceCheck check;
+    Aig::Edge miter = Aig::ZERO;
+    for (const auto &pair : pairs) miter = aig.createOr(miter, aig.createXor(pair.first, pair.second));
+    if (miter == Aig::ZERO) {
+        check.result = Equivalence::EQUIVALENT;
+        return check;
+    }
+
+    std::vector<Aig::Edge> roots{miter};
+    for (const auto &pair : pairs) {
+        roots.push_back(pair.first);
+        roots.push_back(pair.second);
+    }
+    SatSolver solver;
+    std::vector<Literal> literals = encodeAig(solver, aig, roots);
+    solver.addClause({edgeLiteral(literals, miter)});
+
+    SatResult result = solver.solve(budget);
+    check.conflicts = solver.conflictCount();
+    if (result == SatResult::UNSATISFIABLE) {
+        check.result = Equivalence::EQUIVALENT;
+    } else if (result == SatResult::SATISFIABLE) {
+        check.result = Equivalence::DIFFERENT;
+        auto valueOf = [&](Aig::Edge e) {
+            Literal lit = edgeLiteral(literals, e);
+            return static_cast<uint8_t>(solver.modelValue(literalVar(lit)) != (lit & 1));
+        };
+        for (Aig::Edge input : inputs) check.counterexample.push_back(valueOf(input));
+        for (size_t o = 0; o < pairs.size(); ++o) {
+            if (valueOf(pairs[o].first) != valueOf(pairs[o].second)) {
+                check.output = o;
+                break;
+            }
+        }
+    }
+    return check;
+}
+
+}  // namespace
+
+std::vector<Literal> encodeAig(SatSolver &solver, const Aig &aig, const std::vector<Aig::Edge> &roots) {
+    // Node 0 is a variable pinned to 0
+    std::vector<Literal> literals(aig.nodeCount(), makeLiteral(solver.newVariable()));
+    solver.addClause({negateLiteral(literals[0])});
+
+    // Nodes are in topological order, so one backward sweep marks the cones
+    std::vector<uint8_t> inCone(aig.nodeCount(), 0);
+    for (Aig::Edge root : roots) inCone[Aig::nodeOf(root)] = 1;
+    for (size_t n = aig.nodeCount(); n-- > 1;) {
+        if (!inCone[n] || !aig.isAnd(static_cast<uint32_t>(n))) continue;
+        inCone[Aig::nodeOf(aig.getNode(static_cast<uint32_t>(n)).fanin0)] = 1;
+        inCone[Aig::nodeOf(aig.getNode(static_cast<uint32_t>(n)).fanin1)] = 1;
+    }
+
+    for (uint32_t n = 1; n < aig.nodeCount(); ++n) {
+        if (!inCone[n]) continue;
+        literals[n] = makeLiteral(solver.newVariable());
+        if (aig.isInput(n)) continue;
+
+        // y -> a, y -> b, a and b -> y
+        Literal y = literals[n];
+        Literal a = edgeLiteral(literals, aig.getNode(n).fanin0);
+        Literal b = edgeLiteral(literals, aig.getNode(n).fanin1);
+        solver.addClause({negateLiteral(y), a});
+        solver.addClause({negateLiteral(y), b});
+        solver.addClause({y, negateLiteral(a), negateLiteral(b)});
+    }
+    return literals;
+}
+
+EquivalenceCheck checkEquivalence(const Netlist &a, const Netlist &b, std::chrono::milliseconds budget) {
+    Aig aig;
+    std::vector<Aig::Edge> inputs;
+    for (size_t i = 0; i < a.getInputs().size(); ++i) inputs.push_back(aig.createInput());
+
+    std::vector<Aig::Edge> signalsA = lowerNetlist(aig, a, inputs);
+    std::vector<Aig::Edge> signalsB = lowerNetlist(aig, b, inputs);
+    std::vector<std::pair<Aig::Edge, Aig::Edge>> pairs;
+    for (size_t o = 0; o < a.getOutputs().size(); ++o) pairs.push_back({signalsA[a.getOutputs()[o]], signalsB[b.getOutputs()[o]]});
+    return solveMiter(aig, inputs, pairs, budget);
+}
+
+EquivalenceCheck checkEquivalence(const Netlist &netlist, size_t output, const CompiledExpression &expression,
+                                  const std::vector<uint32_t> &inputOf, std::chrono::milliseconds budget) {
+    Aig aig;
+    size_t inputCount = netlist.getInputs().size();
+    for (uint32_t input : inputOf) inputCount = std::max<size_t>(inputCount, input + 1);
+    std::vector<Aig::Edge> inputs;
+    for (size_t i = 0; i < inputCount; ++i) inputs.push_back(aig.createInput());
+
+    std::vector<Aig::Edge> signals = lowerNetlist(aig, netlist, inputs);
+    std::vector<Aig::Edge> variables;
+    for (uint32_t input : inputOf) variables.push_back(inputs[input]);
+    Aig::Edge expressionEdge = lowerExpression(aig, expression, variables);
+    return solveMiter(aig, inputs, {{signals[netlist.getOutputs()[output]], expressionEdge}}, budget);
+}
@@ -0,0 +1,40 @@
+// engine/Equivalence.h
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Aig.h"
+#include "Expression.h"
+#include "Netlist.h"
+#include "Sat.h"
+
+// Tseitin encoding of the AIG cones of the roots, three clauses per AND node. Returns one
+// literal per AIG node; nodes outside the cones keep the literal of constant 0.
+std::vector<Literal> encodeAig(SatSolver &solver, const Aig &aig, const std::vector<Aig::Edge> &roots);
+
+// Literal of an edge under the node literals returned by encodeAig()
+inline Literal edgeLiteral(const std::vector<Literal> &nodeLiterals, Aig::Edge e) { return nodeLiterals[Aig::nodeOf(e)] ^ (e & 1); }
+
+enum class Equivalence { EQUIVALENT, DIFFERENT, UNKNOWN };
+
+struct EquivalenceCheck {
+    Equivalence result = Equivalence::UNKNOWN;
+    std::vector<uint8_t> counterexample;  // one value per miter input when DIFFERENT
+    size_t output = 0;                    // first output that differs under the counterexample
+    size_t conflicts = 0;
+};
+
+// Miter of two netlists with inputs and outputs paired by position: both sides are lowered
+// into one structurally hashed AIG, so shared logic merges before any clause is written,
+// then the XORs of paired outputs are ORed and the solver looks for an input vector that
+// sets the OR. Both must have the same number of inputs and outputs.
+EquivalenceCheck checkEquivalence(const Netlist &a, const Netlist &b, std::chrono::milliseconds budget);
+
+// Miter of one netlist output against an expression. inputOf[j] is the netlist input of
+// expression variable j, or an index from inputCount on for a variable the circuit does
+// not have; the counterexample holds inputCount plus that many extra values.
+EquivalenceCheck checkEquivalence(const Netlist &netlist, size_t output, const CompiledExpression &expression,
+                                  const std::vector<uint32_t> &inputOf, std::chrono::milliseconds budget);
@@ -0,0 +1,156 @@
+// engine/Expression.cpp
+
+#include "Expression.h"
+
+#include <algorithm>
+#include <cctype>
+
+bool CompiledExpression::compile(const std::string &source) {
+    code.clear();
+    variables.clear();
+    maxDepth = 0;
+    error.clear();
+
+    // Dense indices follow the sorted variable letters
+    for (char c : source) {
+        if (std::isalpha(static_cast<unsigned char>(c))) variables.push_back(c);
+    }
+    std::sort(variables.begin(), variables.end());
+    variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+
+    text = &source;
+    pos = 0;
+    depth = 0;
+    bool ok = parseOr();
+    if (ok && peek() != '\0') {
+        char c = peek();
+        if (c == ')') {
+            ok = fail("Unmatched ')'");
+        } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '(' || c == '~') {
+            ok = fail("Expected an operator");
+        } else {
+            ok = fail(std::string("Unexpected '") + c + "'");
+        }
+    }
+    text = nullptr;
+
+    if (!ok) {
+        code.clear();
+        variables.clear();
+        maxDepth = 0;
+        return false;
+    }
+    return true;
+}
+
+void CompiledExpression::evaluateWords(const uint64_t *columns, uint64_t *stack, uint64_t *result, size_t words) const {
+    // Each stack entry is a block of `words` words, so dispatch is paid once per block
+    uint64_t *top = stack;  // next free block
+    for (const Instruction &in : code) {
+        if (in.op == Opcode::VAR) {
+            std::copy_n(columns + in.var * words, words, top);
+            top += words;
+            continue;
+        }
+        if (in.op == Opcode::NOT) {
+            uint64_t *a = top - words;
+            for (size_t w = 0; w < words; ++w) a[w] = ~a[w];
+            continue;
+        }
+
+        top -= words;
+        uint64_t *a = top - words;
+        const uint64_t *b = top;
+        switch (in.op) {
+            case Opcode::AND:
+                for (size_t w = 0; w < words; ++w) a[w] &= b[w];
+                break;
+            case Opcode::OR:
+                for (size_t w = 0; w < words; ++w) a[w] |= b[w];
+                break;
+            case Opcode::XOR:
+                for (size_t w = 0; w < words; ++w) a[w] ^= b[w];
+                break;
+            case Opcode::VAR:
+            case Opcode::NOT:
+                break;
+        }
+    }
+    std::copy_n(stack, words, result);
+}
+
+char CompiledExpression::peek() {
+    while (pos < text->size() && std::isspace(static_cast<unsigned char>((*text)[pos]))) ++pos;
+    return pos < text->size() ? (*text)[pos] : '\0';
+}
+
+void CompiledExpression::emit(Opcode op, uint32_t var) {
+    code.push_back({op, var});
+    if (op == Opcode::VAR) {
+        maxDepth = std::max(maxDepth, ++depth);
+    } else if (op != Opcode::NOT) {
+        --depth;
+    }
+}
+
+bool CompiledExpression::parseOr() {
+    if (!parseAnd()) return false;
+    while (peek() == '+') {
+        ++pos;
+        if (!parseAnd()) return false;
+        emit(Opcode::OR);
+    }
+    return true;
+}
+
+bool CompiledExpression::parseAnd() {
+    if (!parseXor()) return false;
+    while (peek() == '.') {
+        ++pos;
+        if (!parseXor()) return false;
+        emit(Opcode::AND);
+    }
+    return true;
+}
+
+bool CompiledExpression::parseXor() {
+    if (!parseNot()) return false;
+    while (peek() == '^') {
+        ++pos;
+        if (!parseNot()) return false;
+        emit(Opcode::XOR);
+    }
+    return true;
+}
+
+bool CompiledExpression::parseNot() {
+    if (peek() != '~') return parseAtom();
+    ++pos;
+    if (!parseNot()) return false;
+    emit(Opcode::NOT);
+    return true;
+}
+
+bool CompiledExpression::parseAtom() {
+    char c = peek();
+    if (std::isalpha(static_cast<unsigned char>(c))) {
+        ++pos;
+        auto it = std::lower_bound(variables.begin(), variables.end(), c);
+        emit(Opcode::VAR, static_cast<uint32_t>(it - variables.begin()));
+        return true;
+    }
+    if (c == '(') {
+        ++pos;
+        if (!parseOr()) return false;
+        if (peek() != ')') return fail("Missing ')'");
+        ++pos;
+        return true;
+    }
+    if (c == '\0') return fail("Expression ends where an operand was expected");
+    return fail(std::string("Unexpected '") + c + "'");
+}
+
+bool CompiledExpression::fail(const std::string &message) {
+    error = message + " at position " + std::to_string(pos + 1);
+    return false;
+}
@@ -0,0 +1,60 @@
+// engine/Expression.h
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A typed Boolean expression compiled once into flat postfix code. Variables are single
+// letters (case-sensitive), resolved to dense indices in sorted order, so evaluation is
+// array indexing on a caller-preallocated stack instead of map lookups.
+//
+// Grammar, loosest binding first, all binary operators left-associative:
+//   expr := and ('+' and)*        OR
+//   and  := xor ('.' xor)*        AND
+//   xor  := not ('^' not)*        XOR
+//   not  := '~' not | atom        NOT
+//   atom := letter | '(' expr ')'
+class CompiledExpression {
+   public:
+    enum class Opcode : uint8_t { VAR, NOT, AND, OR, XOR };
+
+    struct Instruction {
+        Opcode op;
+        uint32_t var;  // variable index for VAR
+    };
+
+    // Returns false and sets getError() if the text is not a valid expression
+    bool compile(const std::string &text);
+
+    const std::string &getError() const { return error; }
+    const std::vector<char> &getVariables() const { return variables; }
+    size_t variableCount() const { return variables.size(); }
+    const std::vector<Instruction> &getCode() const { return code; }
+    size_t stackSize() const { return maxDepth; }
+
+    // Bit-parallel evaluation over blocks of `words` words, one row per bit: variable j is the
+    // block at columns[j * words], the result is written to result[0..words). stack must
+    // hold stackSize() * words words.
+    void evaluateWords(const uint64_t *columns, uint64_t *stack, uint64_t *result, size_t words) const;
+
+   private:
+    std::vector<Instruction> code;
+    std::vector<char> variables;
+    size_t maxDepth = 0;
+    std::string error;
+
+    // Parser state
+    const std::string *text = nullptr;
+    size_t pos = 0;
+    size_t depth = 0;
+
+    char peek();
+    void emit(Opcode op, uint32_t var = 0);
+    bool parseOr();
+    bool parseAnd();
+    bool parseXor();
+    bool parseNot();
+    bool parseAtom();
+    bool fail(const std::string &message);
+};
@@ -0,0 +1,194 @@
+// engine/ExpressionDag.cpp
+
+#include "ExpressionDag.h"
+
+#include <algorithm>
+
+ExpressionDag::ExpressionDag() {
+    nodes.push_back({Op::ZERO, 0, 0});
+    nodes.push_back({Op::ONE, 0, 0});
+}
+
+uint32_t ExpressionDag::intern(Op op, uint32_t a, uint32_t b) {
+    const uint64_t key = uint64_t(op) << 58 | uint64_t(a) << 29 | b;
+    auto found = unique.find(key);
+    if (found != unique.end()) return found->second;
+    nodes.push_back({op, a, b});
+    unique.emplace(key, static_cast<uint32_t>(nodes.size() - 1));
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+uint32_t ExpressionDag::variable(uint32_t index) { return intern(Op::VAR, index, 0); }
+
+uint32_t ExpressionDag::unknown(uint32_t gate) { return intern(Op::UNKNOWN, gate, 0); }
+
+uint32_t ExpressionDag::make(Op op, uint32_t a, uint32_t b) {
+    if (op == Op::NOT) {
+        if (a == ZERO || a == ONE) return a ^ 1;
+        if (nodes[a].op == Op::NOT) return nodes[a].a;
+        return intern(op, a, 0);
+    }
+
+    // Commutative: constants, which are the smallest nodes, end up in a
+    const bool inverted = op == Op::NAND || op == Op::NOR;
+    if (a > b) std::swap(a, b);
+    switch (op) {
+        case Op::AND:
+        case Op::NAND:
+            if (a == ZERO) return inverted ? ONE : ZERO;
+            if (a == ONE || a == b) return inverted ? make(Op::NOT, b) : b;
+            break;
+        case Op::OR:
+        case Op::NOR:
+            if (a == ONE) return inverted ? ZERO : ONE;
+            if (a == ZERO || a == b) return inverted ? make(Op::NOT, b) : b;
+            break;
+        case Op::XOR:
+            if (a == b) return ZERO;
+            if (a == ZERO) return b;
+            if (a == ONE) return make(Op::NOT, b);
+            break;
+        default:
+            break;
+    }
+    return intern(op, a, b);
+}
+
+std::string ExpressionDag::render(const std::vector<uint32_t> &roots, const std::vector<std::string> &rootNames,
+                                  const std::vector<std::string> &variableNames) const {
+    // Operands always precede their users, so one backward sweep counts the uses below the roots
+    std::vector<uint32_t> uses(nodes.size(), 0);
+    for (uint32_t root : roots) ++uses[root];
+    for (size_t n = nodes.size(); n-- > 0;) {
+        if (uses[n] == 0 || nodes[n].op < Op::NOT) continue;
+        ++uses[nodes[n].a];
+        if (nodes[n].op != Op::NOT) ++uses[nodes[n].b];
+    }
+
+    // Shared operators get names; an inverted leaf is short enough to repeat
+    std::vector<std::string> names(nodes.size());
+    std::string out;
+    size_t bound = 0;
+    for (uint32_t n = 0; n < nodes.size(); ++n) {
+        if (uses[n] < 2 || nodes[n].op < Op::NOT) continue;
+        if (nodes[n].op == Op::NOT && nodes[nodes[n].a].op < Op::NOT) continue;
+        names[n] = "t" + std::to_string(++bound);
+        out += names[n] + " = ";
+        renderInto(n, names, variableNames, out);
+        out += '\n';
+    }
+
+    for (size_t r = 0; r < roots.size(); ++r) {
+        if (r < rootNames.size() && !rootNames[r].empty()) out += rootNames[r] + " = ";
+        if (names[roots[r]].empty()) {
+            renderInto(roots[r], names, variableNames, out);
+        } else {
+            out += names[roots[r]];
+        }
+        if (r + 1 < roots.size()) out += '\n';
+    }
+    return out;
+}
+
+void ExpressionDag::renderInto(uint32_t node, const std::vector<std::string> &names, const std::vector<std::string> &variableNames,
+                               std::string &out) const {
+    auto operand = [&](uint32_t x) {
+        if (names[x].empty()) {
+            renderInto(x, names, variableNames, out);
+        } else {
+            out += names[x];
+        }
+    };
+    auto binary = [&](const char *prefix, const char *symbol) {
+        out += prefix;
+        operand(nodes[node].a);
+        out += symbol;
+        operand(nodes[node].b);
+        out += ')';
+    };
+
+    switch (nodes[node].op) {
+        case Op::ZERO:
+            out += '0';
+            break;
+        case Op::ONE:
+            out += '1';
+            break;
+        case Op::VAR:
+            out += nodes[node].a < variableNames.size() ? variableNames[nodes[node].a] : "?";
+            break;
+        case Op::UNKNOWN:
+            out += '?';
+            break;
+        case Op::NOT:
+            out += "¬(";
+            operand(nodes[node].a);
+            out += ')';
+            break;
+        case Op::AND:
+            binary("(", " ∧ ");
+            break;
+        case Op::OR:
+            binary("(", " ∨ ");
+            break;
+        case Op::XOR:
+            binary("(", " ⊕ ");
+            break;
+        case Op::NAND:
+            binary("¬(", " ∧ ");
+            break;
+        case Op::NOR:
+            binary("¬(", " ∨ ");
+            break;
+    }
+}
+
+std::vector<uint32_t> buildNetlistExpressions(ExpressionDag &dag, const Netlist &netlist) {
+    using Op = ExpressionDag::Op;
+    std::vector<uint32_t> signals(netlist.signalCount(), ExpressionDag::ZERO);
+    for (uint32_t g = 0; g < netlist.gateCount(); ++g) {
+        if (netlist.getLevel(g) == Netlist::UNREACHED) signals[g] = dag.unknown(g);
+    }
+    uint32_t variable = 0;
+    for (uint32_t g : netlist.getInputs()) signals[g] = dag.variable(variable++);
+    for (uint32_t g : netlist.getRegisters()) signals[g] = dag.variable(variable++);
+    for (uint32_t g : netlist.getClocks()) signals[g] = dag.variable(variable++);
+
+    for (uint32_t g : netlist.getOrder()) {
+        const uint32_t *pin = netlist.faninBegin(g);
+        const uint32_t *end = netlist.faninEnd(g);
+        const GateType type = netlist.getType(g);
+        if (Gate::isSource(type)) continue;
+        if (type == GateType::NOT || type == GateType::OUTPUT) {
+            signals[g] = type == GateType::NOT ? dag.make(Op::NOT, signals[*pin]) : signals[*pin];
+            continue;
+        }
+
+        // Wider gates chain through the plain operator; only the last step inverts
+        const Op op = type == GateType::AND || type == GateType::NAND ? Op::AND : type == GateType::OR || type == GateType::NOR ? Op::OR : Op::XOR;
+        const Op last = type == GateType::NAND ? Op::NAND : type == GateType::NOR ? Op::NOR : op;
+        uint32_t value = signals[*pin++];
+        for (; pin != end; ++pin) value = dag.make(pin + 1 == end ? last : op, value, signals[*pin]);
+        signals[g] = value;
+    }
+    return signals;
+}
+
+std::string CircuitExpressions::render() const {
+    if (outputs.size() == 1) return dag.render(outputs, {}, inputNames);
+    return dag.render(outputs, outputNames, inputNames);
+}
+
+CircuitExpressions extractCircuitExpressions(const Netlist &netlist) {
+    CircuitExpressions result;
+    for (size_t i = 0; i < netlist.getInputs().size(); ++i) result.inputNames.push_back(std::string(1, static_cast<char>('A' + i)));
+    for (size_t r = 0; r < netlist.getRegisters().size(); ++r) result.inputNames.push_back("Q" + std::to_string(r));
+    for (size_t c = 0; c < netlist.getClocks().size(); ++c) result.inputNames.push_back("Clk" + std::to_string(c));
+
+    std::vector<uint32_t> signals = buildNetlistExpressions(result.dag, netlist);
+    for (size_t o = 0; o < netlist.getOutputs().size(); ++o) {
+        result.outputNames.push_back("Out" + std::to_string(o));
+        result.outputs.push_back(signals[netlist.getOutputs()[o]]);
+    }
+    return result;
+}
@@ -0,0 +1,70 @@
+// engine/ExpressionDag.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Netlist.h"
+
+// Hash-consed Boolean expression DAG. Each distinct operator and operand pair is one node,
+// so reconvergent fan-out shares a subexpression instead of copying it, and text is only
+// produced once by render(), where every subexpression used more than once is written
+// as a named intermediate signal (t1 = ..., t2 = ...) ahead of the roots that use it.
+class ExpressionDag {
+   public:
+    enum class Op : uint8_t { ZERO, ONE, VAR, UNKNOWN, NOT, AND, OR, XOR, NAND, NOR };
+
+    struct Node {
+        Op op;
+        uint32_t a;  // first operand, variable index for VAR, gate for UNKNOWN
+        uint32_t b;  // second operand of binary operators
+    };
+
+    static constexpr uint32_t ZERO = 0;
+    static constexpr uint32_t ONE = 1;
+
+    ExpressionDag();
+
+    uint32_t variable(uint32_t index);
+    uint32_t unknown(uint32_t gate);  // a signal with no expression, e.g. one on a cycle
+    uint32_t make(Op op, uint32_t a, uint32_t b = 0);
+
+    size_t nodeCount() const { return nodes.size(); }
+    const Node &getNode(uint32_t node) const { return nodes[node]; }
+
+    // One binding per shared operator node below the roots, then one line per root,
+    // "name = expression" or just the expression when its name is empty.
+    std::string render(const std::vector<uint32_t> &roots, const std::vector<std::string> &rootNames,
+                       const std::vector<std::string> &variableNames) const;
+
+   private:
+    std::vector<Node> nodes;
+    std::unordered_map<uint64_t, uint32_t> unique;  // (op, a, b) -> node
+
+    uint32_t intern(Op op, uint32_t a, uint32_t b);
+    void renderInto(uint32_t node, const std::vector<std::string> &names, const std::vector<std::string> &variableNames,
+                    std::string &out) const;
+};
+
+// One DAG node per netlist signal (constZero() included), built in a single pass over
+// the levelized order. Input i is variable i, followed by one variable per register and
+// then per clock, so outputs are functions of the inputs and the current state; gates on
+// or behind a cycle are UNKNOWN.
+std::vector<uint32_t> buildNetlistExpressions(ExpressionDag &dag, const Netlist &netlist);
+
+// Expressions of every OUTPUT gate of a netlist from one traversal, sharing one DAG, so
+// logic common to several outputs is built once and rendered as one binding.
+struct CircuitExpressions {
+    ExpressionDag dag;
+    std::vector<std::string> inputNames;   // A, B, ... by input number, then Q0, ... and Clk0, ...
+    std::vector<std::string> outputNames;  // Out0, Out1, ... by output number
+    std::vector<uint32_t> outputs;         // DAG node of each output
+
+    // All outputs with their shared bindings; a single output is written without its name
+    std::string render() const;
+};
+
+CircuitExpressions extractCircuitExpressions(const Netlist &netlist);
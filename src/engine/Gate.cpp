@@ -18,6 +18,15 @@ Gate::Gate(GateType type, sf::Vector2f position) : type(type), position(position
         case GateType::NOT:
             shape.setFillColor(sf::Color(200, 200, 200));
             break;
+        case GateType::DFF:
+        case GateType::LATCH:
+            shape.setFillColor(sf::Color(170, 190, 230));
+            break;
+        case GateType::CLOCK:
+            shape.setFillColor(sf::Color(230, 200, 120));
+            break;
+        default:
+            break;
     }
 }
 
@@ -53,40 +62,93 @@ void Gate::draw(sf::RenderWindow &window) const {
 
 int Gate::getInputCount() const {
     if (type == GateType::NOT || type == GateType::OUTPUT) return 1;
+    if (type == GateType::DFF || type == GateType::LATCH) return 2;
+    if (type == GateType::CLOCK) return 0;
     return std::max(1, static_cast<int>(inputGates.size()));
 }
 
 bool Gate::evaluate() const {
-    std::vector<bool> inputStates;
-    for (auto *g : inputGates) {
-        inputStates.push_back(g->getState());
+    if (isSource(type)) return state;
+    uint64_t mask = 0;
+    for (size_t i = 0; i < inputGates.size() && i < 64; ++i) {
+        if (inputGates[i]->getState()) mask |= uint64_t(1) << i;
     }
-    return evaluate(inputStates);
+    return evaluateMask(type, mask, static_cast<int>(inputGates.size()));
 }
 
-bool Gate::evaluate(const std::vector<bool> &inputs) const {
+bool Gate::evaluateMask(GateType type, uint64_t inputMask, int inputCount) {
     switch (type) {
         case GateType::AND:
-            return !inputs.empty() && std::all_of(inputs.begin(), inputs.end(), [](bool v) { return v; });
+            return evaluateMask<GateType::AND>(inputMask, inputCount);
         case GateType::OR:
-            return std::any_of(inputs.begin(), inputs.end(), [](bool v) { return v; });
+            return evaluateMask<GateType::OR>(inputMask, inputCount);
         case GateType::NOT:
-            return inputs.empty() ? false : !inputs[0];
-        case GateType::INPUT:
-            return state;
-        case GateType::OUTPUT:
-            return inputs.empty() ? false : inputs[0];
+            return evaluateMask<GateType::NOT>(inputMask, inputCount);
         case GateType::NAND:
-            return inputs.empty() ? true : !std::all_of(inputs.begin(), inputs.end(), [](bool v) { return v; });
+            return evaluateMask<GateType::NAND>(inputMask, inputCount);
         case GateType::NOR:
-            return !std::any_of(inputs.begin(), inputs.end(), [](bool v) { return v; });
+            return evaluateMask<GateType::NOR>(inputMask, inputCount);
         case GateType::XOR:
-            return inputs.size() == 2 ? (inputs[0] != inputs[1]) : false;
+            return evaluateMask<GateType::XOR>(inputMask, inputCount);
+        case GateType::OUTPUT:
+            return evaluateMask<GateType::OUTPUT>(inputMask, inputCount);
         default:
             return false;
     }
 }
 
+uint8_t Gate::evaluateSignals(GateType type, const uint8_t *signals, const uint32_t *pin, const uint32_t *end) {
+    switch (type) {
+        case GateType::AND:
+            return evaluateSignals<GateType::AND>(signals, pin, end);
+        case GateType::OR:
+            return evaluateSignals<GateType::OR>(signals, pin, end);
+        case GateType::NOT:
+            return evaluateSignals<GateType::NOT>(signals, pin, end);
+        case GateType::NAND:
+            return evaluateSignals<GateType::NAND>(signals, pin, end);
+        case GateType::NOR:
+            return evaluateSignals<GateType::NOR>(signals, pin, end);
+        case GateType::XOR:
+            return evaluateSignals<GateType::XOR>(signals, pin, end);
+        case GateType::OUTPUT:
+            return evaluateSignals<GateType::OUTPUT>(signals, pin, end);
+        default:
+            return 0;
+    }
+}
+
+void Gate::setState(bool val) { state = val; }
+
+std::string Gate::getGateTypeString() const {
+    switch (type) {
+        case GateType::AND:
+            return "AND";
+        case GateType::OR:
+            return "OR";
+        case GateType::NOT:
+            return "NOT";
+        case GateType::NAND:
+            return "NAND";
+        case GateType::NOR:
+            return "NOR";
+        case GateType::XOR:
+            return "XOR";
+        case GateType::INPUT:
+            return "IN";
+        case GateType::OUTPUT:
+            return "OUT";
+        case GateType::DFF:
+            return "DFF";
+        case GateType::LATCH:
+            return "LATCH";
+        case GateType::CLOCK:
+            return "CLK";
+        default:
+            return "?";
+    }
+}
+
 sf::Vector2f Gate::getInputPinPosition(int pinIndex) const {
     int count = getInputCount();
     if (count == 1) return position + sf::Vector2f{0.f, shape.getSize().y / 2.f};
@@ -1,11 +1,12 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <algorithm>
+#include <cstdint>
 #include <numeric>
 #include <string>
 #include <vector>
 
-enum class GateType { AND, OR, NOT, NAND, NOR, XOR, INPUT, OUTPUT };
+enum class GateType { AND, OR, NOT, NAND, NOR, XOR, INPUT, OUTPUT, DFF, LATCH, CLOCK };
 
 class Gate {
    private:
@@ -31,9 +32,25 @@ class Gate {
 
     int getInputCount() const;
 
+    // Gates whose output is not a function of their pins while the logic settles: INPUT and CLOCK
+    // gates are set from outside, DFF (pins D, CLK) and LATCH (pins D, EN) hold their state
+    static bool isSource(GateType type) {
+        return type == GateType::INPUT || type == GateType::CLOCK || type == GateType::DFF || type == GateType::LATCH;
+    }
+
     // Evaluation
     bool evaluate() const;
-    bool evaluate(const std::vector<bool>& inputs) const;
+
+    // Allocation-free gate logic, specialized per GateType at compile time. Inputs come either as a
+    // packed bitmask (bit i = input i) or as fan-in indices into a flat 0/1 signal array.
+    template <GateType T>
+    static bool evaluateMask(uint64_t inputMask, int inputCount);
+    template <GateType T>
+    static uint8_t evaluateSignals(const uint8_t* signals, const uint32_t* pin, const uint32_t* end);
+
+    // Runtime dispatch onto the specializations above
+    static bool evaluateMask(GateType type, uint64_t inputMask, int inputCount);
+    static uint8_t evaluateSignals(GateType type, const uint8_t* signals, const uint32_t* pin, const uint32_t* end);
 
     // Drawing
     void draw(sf::RenderWindow& window) const;
@@ -55,3 +72,50 @@ class Gate {
     // Font
     void setFont(sf::Font& f) { font = &f; }
 };
+
+template <GateType T>
+bool Gate::evaluateMask(uint64_t inputMask, int inputCount) {
+    const uint64_t all = inputCount >= 64 ? ~uint64_t(0) : (uint64_t(1) << inputCount) - 1;
+    inputMask &= all;
+
+    if constexpr (T == GateType::AND) {
+        return inputCount > 0 && inputMask == all;
+    } else if constexpr (T == GateType::NAND) {
+        return !(inputCount > 0 && inputMask == all);
+    } else if constexpr (T == GateType::OR) {
+        return inputMask != 0;
+    } else if constexpr (T == GateType::NOR) {
+        return inputMask == 0;
+    } else if constexpr (T == GateType::XOR) {
+        return __builtin_popcountll(inputMask) & 1;
+    } else if constexpr (T == GateType::NOT) {
+        return inputCount > 0 && !(inputMask & 1);
+    } else if constexpr (T == GateType::OUTPUT) {
+        return inputMask & 1;
+    } else {
+        return false;  // sources carry their own state
+    }
+}
+
+template <GateType T>
+uint8_t Gate::evaluateSignals(const uint8_t* signals, const uint32_t* pin, const uint32_t* end) {
+    if constexpr (T == GateType::AND || T == GateType::NAND) {
+        uint8_t v = pin != end;
+        for (; pin != end; ++pin) v &= signals[*pin];
+        return T == GateType::NAND ? v ^ 1 : v;
+    } else if constexpr (T == GateType::OR || T == GateType::NOR) {
+        uint8_t v = 0;
+        for (; pin != end; ++pin) v |= signals[*pin];
+        return T == GateType::NOR ? v ^ 1 : v;
+    } else if constexpr (T == GateType::XOR) {
+        uint8_t v = 0;
+        for (; pin != end; ++pin) v ^= signals[*pin];
+        return v;
+    } else if constexpr (T == GateType::NOT) {
+        return pin != end ? signals[*pin] ^ 1 : 0;
+    } else if constexpr (T == GateType::OUTPUT) {
+        return pin != end ? signals[*pin] : 0;
+    } else {
+        return 0;
+    }
+}
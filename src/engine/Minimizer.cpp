@@ -0,0 +1,584 @@
+// engine/Minimizer.cpp
+
+#include "Minimizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Parallel.h"
+
+namespace {
+
+const size_t DEADLINE_CHECK_TERMS = 1024;
+
+}  // namespace
+
+bool findPrimeImplicants(const TruthTable &table, size_t output, std::vector<Cube> &primes, std::chrono::steady_clock::time_point deadline) {
+    const size_t n = table.getInputCount();
+    const uint64_t inputMask = n >= 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1;
+
+    std::vector<Cube> current;
+    table.forEachOnRow(output, [&](uint64_t row) { current.push_back({row, 0}); });
+
+    primes.clear();
+    std::unordered_map<Cube, uint32_t, CubeHash> index;
+    std::vector<size_t> groupStart;
+    std::vector<uint8_t> usedAsLower, usedAsUpper;
+    std::vector<std::vector<Cube>> combined;
+
+    std::atomic<bool> expired{false};
+    while (!current.empty()) {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+
+        // Bucket by popcount: a term can only combine with one that has exactly one more 1
+        std::stable_sort(current.begin(), current.end(), [](const Cube &a, const Cube &b) {
+            return __builtin_popcountll(a.value) < __builtin_popcountll(b.value);
+        });
+        groupStart.assign(n + 2, current.size());
+        for (size_t i = current.size(); i-- > 0;) groupStart[__builtin_popcountll(current[i].value)] = i;
+        for (size_t k = n + 1; k-- > 0;) groupStart[k] = std::min(groupStart[k], groupStart[k + 1]);
+
+        index.clear();
+        index.reserve(current.size());
+        for (size_t i = 0; i < current.size(); ++i) index.emplace(current[i], static_cast<uint32_t>(i));
+
+        // Each bucket pair (k, k + 1) marks only its own lower and upper terms, so pairs run in parallel
+        usedAsLower.assign(current.size(), 0);
+        usedAsUpper.assign(current.size(), 0);
+        combined.assign(n, {});
+        parallelFor(n, 1, [&](size_t begin, size_t end, size_t) {
+            for (size_t k = begin; k < end; ++k) {
+                for (size_t i = groupStart[k]; i < groupStart[k + 1]; ++i) {
+                    // A single pass can be long on wide tables, so it checks the deadline too
+                    if (i % DEADLINE_CHECK_TERMS == 0 && (expired || std::chrono::steady_clock::now() >= deadline)) {
+                        expired = true;
+                        return;
+                    }
+                    const Cube a = current[i];
+                    for (uint64_t free = inputMask & ~a.mask & ~a.value; free != 0; free &= free - 1) {
+                        uint64_t bit = free & -free;
+                        auto partner = index.find({a.value | bit, a.mask});
+                        if (partner == index.end()) continue;
+                        usedAsLower[i] = 1;
+                        usedAsUpper[partner->second] = 1;
+                        combined[k].push_back({a.value, a.mask | bit});
+                    }
+                }
+            }
+        });
+        if (expired) return false;
+
+        for (size_t i = 0; i < current.size(); ++i) {
+            if (!usedAsLower[i] && !usedAsUpper[i]) primes.push_back(current[i]);
+        }
+
+        // The same term is produced once per pair of halves it can be split into
+        std::unordered_set<Cube, CubeHash> seen;
+        current.clear();
+        for (const auto &terms : combined) {
+            for (const Cube &cube : terms) {
+                if (seen.insert(cube).second) current.push_back(cube);
+            }
+        }
+    }
+    return true;
+}
+
+namespace {
+
+// Rows of a word where row bit k (k < 6) is set
+const uint64_t LOW_BIT_PATTERNS[6] = {0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+                                      0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+
+bool contains(const Cube &outer, const Cube &inner) { return (inner.mask & ~outer.mask) == 0 && ((inner.value ^ outer.value) & ~outer.mask) == 0; }
+bool intersects(const Cube &a, const Cube &b) { return ((a.value ^ b.value) & ~a.mask & ~b.mask) == 0; }
+
+// Rows of the cube inside one column word (the same for every word it touches)
+uint64_t wordPattern(const Cube &cube) {
+    uint64_t pattern = ~uint64_t(0);
+    for (int k = 0; k < 6; ++k) {
+        if (cube.mask >> k & 1) continue;
+        pattern &= (cube.value >> k & 1) ? LOW_BIT_PATTERNS[k] : ~LOW_BIT_PATTERNS[k];
+    }
+    return pattern;
+}
+
+bool touchesWord(const Cube &cube, uint64_t word) { return ((word ^ (cube.value >> 6)) & ~(cube.mask >> 6)) == 0; }
+
+// Calls fn(word) for every column word the cube touches
+template <typename Fn>
+void forEachWord(const Cube &cube, Fn fn) {
+    const uint64_t base = cube.value >> 6;
+    const uint64_t free = cube.mask >> 6;
+    uint64_t subset = 0;
+    do {
+        fn(base | subset);
+        subset = (subset - free) & free;
+    } while (subset != 0);
+}
+
+// Espresso-style heuristic over an explicit on-set column. Every check against the
+// off-set is a word scan of the column, so cubes never need an off-set cover.
+class HeuristicMinimizer {
+   public:
+    HeuristicMinimizer(const TruthTable &table, size_t output, std::chrono::milliseconds budget)
+        : on(table.column(output)), words(table.wordCount()), inputCount(table.getInputCount()),
+          deadline(std::chrono::steady_clock::now() + budget) {}
+
+    // Each step keeps the cover valid, so any of them may stop early when the budget runs out;
+    // only the initial cover always completes
+    std::vector<Cube> run() {
+        initialCover();
+        irredundant();
+
+        // Reduce / expand / irredundant until a round brings no gain or time runs out
+        std::vector<Cube> best = cover;
+        for (unsigned round = 1; !expired(); ++round) {
+            reduce();
+            std::vector<size_t> order = literalOrder(round);
+            for (Cube &cube : cover) {
+                if (expired()) break;
+                cube = expand(cube, order);
+            }
+            removeContained();
+            irredundant();
+
+            if (!better(cover, best)) break;
+            best = cover;
+        }
+        return best;
+    }
+
+   private:
+    const uint64_t *on;
+    size_t words;
+    size_t inputCount;
+    std::chrono::steady_clock::time_point deadline;
+    std::vector<Cube> cover;
+
+    bool expired() const { return std::chrono::steady_clock::now() >= deadline; }
+
+    bool isImplicant(const Cube &cube) const {
+        const uint64_t pattern = wordPattern(cube);
+        bool ok = true;
+        forEachWord(cube, [&](uint64_t w) { ok = ok && (pattern & ~on[w]) == 0; });
+        return ok;
+    }
+
+    size_t literals(const std::vector<Cube> &cubes) const {
+        size_t total = 0;
+        for (const Cube &cube : cubes) total += cube.literalCount(inputCount);
+        return total;
+    }
+
+    bool better(const std::vector<Cube> &a, const std::vector<Cube> &b) const {
+        return a.size() < b.size() || (a.size() == b.size() && literals(a) < literals(b));
+    }
+
+    // Literals most cubes already dropped go first, so cubes grow towards each other and
+    // become redundant; the round number rotates ties so later rounds try other directions
+    std::vector<size_t> literalOrder(unsigned round) const {
+        std::vector<size_t> dropped(inputCount, 0);
+        for (const Cube &cube : cover) {
+            for (size_t k = 0; k < inputCount; ++k) dropped[k] += cube.mask >> k & 1;
+        }
+        std::vector<size_t> order(inputCount);
+        for (size_t k = 0; k < inputCount; ++k) order[k] = (k + round) % inputCount;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return dropped[a] > dropped[b]; });
+        return order;
+    }
+
+    // Raises literals in order while the cube stays inside the on-set
+    Cube expand(Cube cube, const std::vector<size_t> &order) const {
+        for (size_t k : order) {
+            uint64_t bit = uint64_t(1) << k;
+            if (cube.mask & bit) continue;
+            // Only the half on the other side of the literal is new
+            if (isImplicant({cube.value ^ bit, cube.mask})) cube = {cube.value & ~bit, cube.mask | bit};
+        }
+        return cube;
+    }
+
+    // Greedy seed cover: expand the first uncovered on-row until every on-row is covered
+    void initialCover() {
+        std::vector<uint64_t> covered(words, 0);
+        const std::vector<size_t> order = literalOrder(0);
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t open = on[w] & ~covered[w]; open != 0; open = on[w] & ~covered[w]) {
+                Cube cube = expand({uint64_t(w) * 64 + static_cast<uint64_t>(__builtin_ctzll(open)), 0}, order);
+                const uint64_t pattern = wordPattern(cube);
+                forEachWord(cube, [&](uint64_t x) { covered[x] |= pattern; });
+                cover.push_back(cube);
+            }
+        }
+    }
+
+    // Rows of cover[index] inside word w that no other live cube covers
+    uint64_t uniqueRows(size_t index, const std::vector<size_t> &neighbours, const std::vector<uint8_t> &alive, uint64_t w) const {
+        uint64_t others = 0;
+        for (size_t j : neighbours) {
+            if (alive[j] && touchesWord(cover[j], w)) others |= wordPattern(cover[j]);
+        }
+        return wordPattern(cover[index]) & ~others;
+    }
+
+    std::vector<size_t> neighboursOf(size_t index) const {
+        std::vector<size_t> result;
+        for (size_t j = 0; j < cover.size(); ++j) {
+            if (j != index && intersects(cover[index], cover[j])) result.push_back(j);
+        }
+        return result;
+    }
+
+    // Drops cubes whose rows are all covered by the rest, smallest cubes first
+    void irredundant() {
+        std::vector<size_t> order(cover.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return __builtin_popcountll(cover[a].mask) < __builtin_popcountll(cover[b].mask);
+        });
+
+        std::vector<uint8_t> alive(cover.size(), 1);
+        for (size_t i : order) {
+            if (expired()) break;
+            std::vector<size_t> neighbours = neighboursOf(i);
+            bool redundant = true;
+            forEachWord(cover[i], [&](uint64_t w) { redundant = redundant && uniqueRows(i, neighbours, alive, w) == 0; });
+            if (redundant) alive[i] = 0;
+        }
+        compact(alive);
+    }
+
+    // Shrinks every cube to the smallest cube holding the rows only it covers, largest first,
+    // so the next expand can grow it in a different direction
+    void reduce() {
+        std::vector<size_t> order(cover.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return __builtin_popcountll(cover[a].mask) > __builtin_popcountll(cover[b].mask);
+        });
+
+        std::vector<uint8_t> alive(cover.size(), 1);
+        for (size_t i : order) {
+            if (expired()) break;
+            std::vector<size_t> neighbours = neighboursOf(i);
+            uint64_t allOnes = ~uint64_t(0), anyOnes = 0;
+            bool hasUnique = false;
+            forEachWord(cover[i], [&](uint64_t w) {
+                uint64_t unique = uniqueRows(i, neighbours, alive, w);
+                if (unique == 0) return;
+                hasUnique = true;
+                allOnes &= (w << 6) | 0x3F;
+                anyOnes |= w << 6;
+                for (int k = 0; k < 6; ++k) {
+                    if (unique & ~LOW_BIT_PATTERNS[k]) allOnes &= ~(uint64_t(1) << k);
+                    if (unique & LOW_BIT_PATTERNS[k]) anyOnes |= uint64_t(1) << k;
+                }
+            });
+            if (!hasUnique) {
+                alive[i] = 0;
+                continue;
+            }
+            const uint64_t inputMask = inputCount >= 64 ? ~uint64_t(0) : (uint64_t(1) << inputCount) - 1;
+            cover[i] = {allOnes & inputMask, (allOnes ^ anyOnes) & inputMask};
+        }
+        compact(alive);
+    }
+
+    void removeContained() {
+        std::vector<uint8_t> alive(cover.size(), 1);
+        for (size_t i = 0; i < cover.size() && !expired(); ++i) {
+            for (size_t j = 0; j < cover.size() && alive[i]; ++j) {
+                if (i == j || !alive[j] || !contains(cover[j], cover[i])) continue;
+                if (cover[i] != cover[j] || j < i) alive[i] = 0;
+            }
+        }
+        compact(alive);
+    }
+
+    void compact(const std::vector<uint8_t> &alive) {
+        size_t kept = 0;
+        for (size_t i = 0; i < cover.size(); ++i) {
+            if (alive[i]) cover[kept++] = cover[i];
+        }
+        cover.resize(kept);
+    }
+};
+
+// Bitsets over the rows or columns of a prime implicant chart
+using Bits = std::vector<uint64_t>;
+
+bool testBit(const Bits &bits, size_t i) { return bits[i >> 6] >> (i & 63) & 1; }
+void setBit(Bits &bits, size_t i) { bits[i >> 6] |= uint64_t(1) << (i & 63); }
+void clearBit(Bits &bits, size_t i) { bits[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+
+size_t countAnd(const Bits &a, const Bits &b) {
+    size_t count = 0;
+    for (size_t w = 0; w < a.size(); ++w) count += __builtin_popcountll(a[w] & b[w]);
+    return count;
+}
+
+// (a & active) is a subset of b
+bool subsetWithin(const Bits &a, const Bits &b, const Bits &active) {
+    for (size_t w = 0; w < a.size(); ++w) {
+        if (a[w] & active[w] & ~b[w]) return false;
+    }
+    return true;
+}
+
+// Calls fn(i) for every bit set in a & b
+template <typename Fn>
+void forEachAnd(const Bits &a, const Bits &b, Fn fn) {
+    for (size_t w = 0; w < a.size(); ++w) {
+        for (uint64_t bits = a[w] & b[w]; bits != 0; bits &= bits - 1) fn(w * 64 + static_cast<size_t>(__builtin_ctzll(bits)));
+    }
+}
+
+// Picks a minimum-cost subset of the primes that covers every on-row. The chart is reduced
+// by essential primes and row / column dominance, then the cyclic core is solved by branch
+// and bound, reducing again at every node. A cube costs more than any number of literals,
+// so the cover has the fewest cubes first and the fewest literals second. Past the deadline
+// the best cover found so far is returned (at worst the greedy one).
+class CoverSelector {
+   public:
+    CoverSelector(const TruthTable &table, size_t output, const std::vector<Cube> &primes, std::chrono::milliseconds budget)
+        : primes(primes), deadline(std::chrono::steady_clock::now() + budget) {
+        std::vector<uint64_t> rows;
+        table.forEachOnRow(output, [&](uint64_t row) { rows.push_back(row); });
+
+        rowWords = (rows.size() + 63) / 64;
+        columnWords = (primes.size() + 63) / 64;
+        rowColumns.assign(rows.size(), Bits(columnWords, 0));
+        columnRows.assign(primes.size(), Bits(rowWords, 0));
+        for (size_t r = 0; r < rows.size(); ++r) {
+            for (size_t c = 0; c < primes.size(); ++c) {
+                if (!primes[c].covers(rows[r])) continue;
+                setBit(rowColumns[r], c);
+                setBit(columnRows[c], r);
+            }
+        }
+        for (const Cube &prime : primes) cost.push_back(CUBE_COST + prime.literalCount(table.getInputCount()));
+    }
+
+    std::vector<Cube> run() {
+        Chart root;
+        root.rows.assign(rowWords, 0);
+        root.columns.assign(columnWords, 0);
+        for (size_t r = 0; r < rowColumns.size(); ++r) setBit(root.rows, r);
+        for (size_t c = 0; c < primes.size(); ++c) setBit(root.columns, c);
+
+        if (reduce(root)) {
+            best = greedy(root);
+            search(root);
+        } else {
+            best.chosen.clear();
+            for (size_t c = 0; c < primes.size(); ++c) best.chosen.push_back(static_cast<uint32_t>(c));
+        }
+
+        std::vector<Cube> result;
+        for (uint32_t c : best.chosen) result.push_back(primes[c]);
+        return result;
+    }
+
+   private:
+    static constexpr uint64_t CUBE_COST = 65;
+
+    struct Chart {
+        Bits rows;     // on-rows still to cover
+        Bits columns;  // primes still available
+        std::vector<uint32_t> chosen;
+        uint64_t cost = 0;
+    };
+
+    const std::vector<Cube> &primes;
+    std::chrono::steady_clock::time_point deadline;
+    size_t rowWords = 0, columnWords = 0;
+    std::vector<Bits> rowColumns;  // primes covering each on-row
+    std::vector<Bits> columnRows;  // on-rows covered by each prime
+    std::vector<uint64_t> cost;
+    Chart best;
+
+    bool expired() const { return std::chrono::steady_clock::now() >= deadline; }
+
+    static bool empty(const Bits &bits) {
+        return std::all_of(bits.begin(), bits.end(), [](uint64_t w) { return w == 0; });
+    }
+
+    void choose(Chart &chart, size_t c) const {
+        chart.chosen.push_back(static_cast<uint32_t>(c));
+        chart.cost += cost[c];
+        clearBit(chart.columns, c);
+        for (size_t w = 0; w < rowWords; ++w) chart.rows[w] &= ~columnRows[c][w];
+    }
+
+    // Applies essential primes and row / column dominance until nothing changes; returns
+    // false if some row can no longer be covered
+    bool reduce(Chart &chart) const {
+        for (bool changed = true; changed;) {
+            changed = false;
+
+            // A row covered by a single prime forces that prime
+            bool infeasible = false;
+            forEachAnd(chart.rows, chart.rows, [&](size_t r) {
+                if (infeasible || !testBit(chart.rows, r)) return;
+                size_t count = countAnd(rowColumns[r], chart.columns);
+                if (count == 0) {
+                    infeasible = true;
+                } else if (count == 1) {
+                    forEachAnd(rowColumns[r], chart.columns, [&](size_t c) { choose(chart, c); });
+                    changed = true;
+                }
+            });
+            if (infeasible) return false;
+
+            // A row whose primes include all primes of another row is covered whenever that
+            // one is, so it can be dropped. Candidates share the other row's first prime.
+            forEachAnd(chart.rows, chart.rows, [&](size_t r) {
+                if (!testBit(chart.rows, r)) return;
+                size_t first = 0;
+                forEachAnd(rowColumns[r], chart.columns, [&](size_t c) { first = first ? first : c + 1; });
+                if (first == 0) return;
+                forEachAnd(columnRows[first - 1], chart.rows, [&](size_t other) {
+                    if (other == r || !testBit(chart.rows, other)) return;
+                    if (!subsetWithin(rowColumns[r], rowColumns[other], chart.columns)) return;
+                    if (subsetWithin(rowColumns[other], rowColumns[r], chart.columns) && other < r) return;
+                    clearBit(chart.rows, other);
+                    changed = true;
+                });
+            });
+
+            // A prime whose rows are all covered by another prime of no higher cost is never
+            // needed. Candidates cover the prime's first row.
+            forEachAnd(chart.columns, chart.columns, [&](size_t c) {
+                if (!testBit(chart.columns, c)) return;
+                size_t first = 0;
+                forEachAnd(columnRows[c], chart.rows, [&](size_t r) { first = first ? first : r + 1; });
+                if (first == 0) {
+                    clearBit(chart.columns, c);
+                    changed = true;
+                    return;
+                }
+                bool dominated = false;
+                forEachAnd(rowColumns[first - 1], chart.columns, [&](size_t other) {
+                    if (dominated || other == c || cost[other] > cost[c]) return;
+                    if (!subsetWithin(columnRows[c], columnRows[other], chart.rows)) return;
+                    bool tie = cost[other] == cost[c] && subsetWithin(columnRows[other], columnRows[c], chart.rows);
+                    dominated = !tie || other < c;
+                });
+                if (dominated) {
+                    clearBit(chart.columns, c);
+                    changed = true;
+                }
+            });
+
+            if (expired()) break;
+        }
+        return true;
+    }
+
+    // Repeatedly takes the prime with the most uncovered rows per unit of cost, keeping
+    // per-prime counts of uncovered rows up to date as rows get covered
+    Chart greedy(Chart chart) const {
+        std::vector<size_t> uncovered(primes.size(), 0);
+        forEachAnd(chart.columns, chart.columns, [&](size_t c) { uncovered[c] = countAnd(columnRows[c], chart.rows); });
+        while (!empty(chart.rows)) {
+            size_t pick = 0;
+            double bestRatio = -1;
+            forEachAnd(chart.columns, chart.columns, [&](size_t c) {
+                double ratio = static_cast<double>(uncovered[c]) / cost[c];
+                if (ratio > bestRatio) {
+                    bestRatio = ratio;
+                    pick = c;
+                }
+            });
+            forEachAnd(columnRows[pick], chart.rows, [&](size_t r) {
+                forEachAnd(rowColumns[r], chart.columns, [&](size_t c) { --uncovered[c]; });
+            });
+            choose(chart, pick);
+        }
+        return chart;
+    }
+
+    // Rows with pairwise disjoint primes each need their own prime
+    uint64_t lowerBound(const Chart &chart) const {
+        Bits used(columnWords, 0);
+        uint64_t bound = 0;
+        forEachAnd(chart.rows, chart.rows, [&](size_t r) {
+            bool disjoint = true;
+            for (size_t w = 0; w < columnWords && disjoint; ++w) disjoint = (rowColumns[r][w] & chart.columns[w] & used[w]) == 0;
+            if (!disjoint) return;
+            uint64_t cheapest = ~uint64_t(0);
+            forEachAnd(rowColumns[r], chart.columns, [&](size_t c) { cheapest = std::min(cheapest, cost[c]); });
+            bound += cheapest;
+            for (size_t w = 0; w < columnWords; ++w) used[w] |= rowColumns[r][w] & chart.columns[w];
+        });
+        return bound;
+    }
+
+    void search(Chart chart) {
+        if (expired() || !reduce(chart) || chart.cost >= best.cost) return;
+        if (empty(chart.rows)) {
+            best = std::move(chart);
+            return;
+        }
+        if (chart.cost + lowerBound(chart) >= best.cost) return;
+
+        // Branch on the row with the fewest primes, trying the widest primes first
+        size_t row = 0, fewest = ~size_t(0);
+        forEachAnd(chart.rows, chart.rows, [&](size_t r) {
+            size_t count = countAnd(rowColumns[r], chart.columns);
+            if (count < fewest) {
+                fewest = count;
+                row = r;
+            }
+        });
+        std::vector<size_t> candidates;
+        forEachAnd(rowColumns[row], chart.columns, [&](size_t c) { candidates.push_back(c); });
+        std::stable_sort(candidates.begin(), candidates.end(), [&](size_t a, size_t b) {
+            return countAnd(columnRows[a], chart.rows) > countAnd(columnRows[b], chart.rows);
+        });
+
+        for (size_t c : candidates) {
+            Chart next = chart;
+            choose(next, c);
+            search(std::move(next));
+            // Covers with c have been explored
+            clearBit(chart.columns, c);
+            if (expired()) return;
+        }
+    }
+};
+
+}  // namespace
+
+const char *getMinimizeModeName(MinimizeMode mode) {
+    switch (mode) {
+        case MinimizeMode::AUTO:
+            return "auto";
+        case MinimizeMode::EXACT:
+            return "exact";
+        case MinimizeMode::HEURISTIC:
+            return "heuristic";
+    }
+    return "";
+}
+
+std::vector<Cube> minimizeCover(const TruthTable &table, size_t output, const MinimizeOptions &options, MinimizeMode *usedMode) {
+    // One budget for the whole call: whatever prime generation leaves goes to the cover
+    const auto deadline = std::chrono::steady_clock::now() + options.timeBudget;
+    auto remaining = [&] {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        return std::max(left, std::chrono::milliseconds(0));
+    };
+
+    MinimizeMode mode = MinimizeMode::EXACT;
+    if (options.mode == MinimizeMode::HEURISTIC || table.getInputCount() > options.exactMaxInputs) mode = MinimizeMode::HEURISTIC;
+    std::vector<Cube> primes;
+    if (mode == MinimizeMode::EXACT && !findPrimeImplicants(table, output, primes, deadline)) mode = MinimizeMode::HEURISTIC;
+    if (usedMode) *usedMode = mode;
+
+    if (mode == MinimizeMode::EXACT) return CoverSelector(table, output, primes, remaining()).run();
+    return HeuristicMinimizer(table, output, remaining()).run();
+}
@@ -0,0 +1,56 @@
+// engine/Minimizer.h
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "TruthTable.h"
+
+// Product term over the row bits of a truth table: bit i set in mask means row bit i is a
+// don't care, otherwise the term requires row bit i to equal bit i of value. Bits of value
+// under the mask are kept 0 so equal terms compare equal.
+struct Cube {
+    uint64_t value = 0;
+    uint64_t mask = 0;
+
+    bool covers(uint64_t row) const { return ((row ^ value) & ~mask) == 0; }
+    int literalCount(size_t inputCount) const { return static_cast<int>(inputCount) - __builtin_popcountll(mask); }
+    bool operator==(const Cube &other) const { return value == other.value && mask == other.mask; }
+    bool operator!=(const Cube &other) const { return !(*this == other); }
+};
+
+struct CubeHash {
+    size_t operator()(const Cube &cube) const {
+        uint64_t h = cube.value * 0x9E3779B97F4A7C15ull ^ (cube.mask + 0x632BE59BD9B4E019ull);
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+};
+
+// All prime implicants of one output column (Quine-McCluskey). Terms are bucketed by the
+// popcount of their value so only adjacent buckets can combine, a partner is found by hash
+// lookup instead of a pairwise scan, and bucket pairs are combined in parallel.
+// Returns false, with primes incomplete, once the deadline passes.
+bool findPrimeImplicants(const TruthTable &table, size_t output, std::vector<Cube> &primes,
+                         std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+// EXACT: a minimum cover picked from the prime implicants (essential primes, dominance,
+// branch and bound). HEURISTIC: Espresso-style expand / irredundant / reduce loop, good
+// covers for wide functions in bounded time. The number of primes grows up to 3^n, so
+// EXACT falls back to HEURISTIC above exactMaxInputs or when prime generation runs past
+// the budget; AUTO is EXACT with that fallback.
+enum class MinimizeMode { AUTO, EXACT, HEURISTIC };
+
+struct MinimizeOptions {
+    MinimizeMode mode = MinimizeMode::AUTO;
+    size_t exactMaxInputs = 14;
+    std::chrono::milliseconds timeBudget{1000};  // for the whole call; past it the best cover so far is kept
+};
+
+const char *getMinimizeModeName(MinimizeMode mode);
+
+// Sum-of-products cover of one output column: every row where the output is 1 is covered
+// by some cube and no cube covers a row where it is 0. usedMode receives EXACT or HEURISTIC.
+std::vector<Cube> minimizeCover(const TruthTable &table, size_t output, const MinimizeOptions &options = {},
+                                MinimizeMode *usedMode = nullptr);
@@ -0,0 +1,223 @@
+// engine/NativeEvaluator.cpp
+
+#include "NativeEvaluator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char *ENTRY_SYMBOL = "circuit_evaluate";
+
+#ifdef _WIN32
+const char *LIBRARY_EXTENSION = ".dll";
+#else
+const char *LIBRARY_EXTENSION = ".so";
+#endif
+
+std::string readFile(const std::string &path) {
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+// Every build gets a directory only this user can enter, so nothing else can plant or swap
+// the files between writing the source and loading the library
+bool makeWorkDirectory(std::string &path) {
+    std::error_code ec;
+    std::filesystem::path temp = std::filesystem::temp_directory_path(ec);
+    if (ec) temp = ".";
+#ifdef _WIN32
+    static std::atomic<unsigned> counter{0};
+    std::filesystem::path dir = temp / ("dlsim_native_" + std::to_string(GetCurrentProcessId()) + "_" + std::to_string(counter++));
+    if (!std::filesystem::create_directory(dir, ec)) return false;
+    path = dir.string();
+#else
+    std::string pattern = (temp / "dlsim_native_XXXXXX").string();
+    if (!mkdtemp(pattern.data())) return false;  // created with mode 0700
+    path = pattern;
+#endif
+    return true;
+}
+
+}  // namespace
+
+NativeEvaluator::~NativeEvaluator() { unload(); }
+
+void NativeEvaluator::unload() {
+    if (library) {
+#ifdef _WIN32
+        FreeLibrary(static_cast<HMODULE>(library));
+#else
+        dlclose(library);
+#endif
+    }
+    library = nullptr;
+    entry = nullptr;
+
+    std::error_code ec;
+    if (!workDirectory.empty()) std::filesystem::remove_all(workDirectory, ec);
+    workDirectory.clear();
+    sourcePath.clear();
+    libraryPath.clear();
+}
+
+std::string NativeEvaluator::emitSource(const Netlist &netlist) {
+    std::vector<uint32_t> gates;
+    for (uint32_t g : netlist.getOrder()) {
+        if (!Gate::isSource(netlist.getType(g))) gates.push_back(g);
+    }
+
+    std::string src;
+    src += "// Generated by NativeEvaluator: one statement per gate in level order\n";
+    src += "#include <cstddef>\n#include <cstdint>\n\n";
+    src += "#ifdef __GNUC__\n#define SEGMENT __attribute__((noinline)) static\n#else\n#define SEGMENT static\n#endif\n\n";
+
+    // Gates are emitted in segments of SEGMENT_GATES: values produced inside a segment
+    // stay in locals, everything else is read back from v. One (non-inlined) function per
+    // segment keeps live ranges short, otherwise register allocation dominates compile time.
+    std::vector<uint8_t> local(netlist.signalCount(), 0);
+    size_t segmentCount = (gates.size() + SEGMENT_GATES - 1) / SEGMENT_GATES;
+    for (size_t seg = 0; seg < segmentCount; ++seg) {
+        size_t first = seg * SEGMENT_GATES;
+        size_t last = std::min(first + SEGMENT_GATES, gates.size());
+        for (size_t i = first; i < last; ++i) local[gates[i]] = 1;
+
+        auto operand = [&](uint32_t signal) -> std::string {
+            if (signal == netlist.constZero()) return "z";
+            return local[signal] ? "s" + std::to_string(signal) : "v[" + std::to_string(signal) + " * W]";
+        };
+        auto join = [&](uint32_t gate, const char *op) -> std::string {
+            const uint32_t *pin = netlist.faninBegin(gate);
+            const uint32_t *end = netlist.faninEnd(gate);
+            if (pin == end) return "z";
+
+            std::string expr = operand(*pin++);
+            for (; pin != end; ++pin) expr += std::string(" ") + op + " " + operand(*pin);
+            return expr;
+        };
+
+        src += "SEGMENT void segment" + std::to_string(seg) + "(uint64_t *v, size_t W) {\n";
+        src += "    const uint64_t z = 0;\n";
+        for (size_t i = first; i < last; ++i) {
+            uint32_t g = gates[i];
+            std::string expr;
+            switch (netlist.getType(g)) {
+                case GateType::INPUT:
+                case GateType::DFF:
+                case GateType::LATCH:
+                case GateType::CLOCK:
+                    break;
+                case GateType::AND:
+                    expr = join(g, "&");
+                    break;
+                case GateType::NAND:
+                    expr = "~(" + join(g, "&") + ")";
+                    break;
+                case GateType::OR:
+                    expr = join(g, "|");
+                    break;
+                case GateType::NOR:
+                    expr = "~(" + join(g, "|") + ")";
+                    break;
+                case GateType::XOR:
+                    expr = join(g, "^");
+                    break;
+                case GateType::NOT:
+                    expr = "~" + operand(*netlist.faninBegin(g));
+                    break;
+                case GateType::OUTPUT:
+                    expr = operand(*netlist.faninBegin(g));
+                    break;
+            }
+            std::string name = "s" + std::to_string(g);
+            src += "    const uint64_t " + name + " = " + expr + ";\n";
+            src += "    v[" + std::to_string(g) + " * W] = " + name + ";\n";
+        }
+        src += "}\n\n";
+
+        for (size_t i = first; i < last; ++i) local[gates[i]] = 0;
+    }
+
+    src += "extern \"C\"\n#ifdef _WIN32\n__declspec(dllexport)\n#endif\n";
+    src += "void " + std::string(ENTRY_SYMBOL) + "(uint64_t *v, size_t W) {\n";
+    src += "    for (size_t w = 0; w < W; ++w) {\n";
+    src += "        v[" + std::to_string(netlist.constZero()) + " * W + w] = 0;\n";
+    // Gates behind a cycle are never evaluated and read as 0, clocks and registers hold their reset state
+    for (uint32_t g = 0; g < netlist.gateCount(); ++g) {
+        const GateType type = netlist.getType(g);
+        if (netlist.getLevel(g) == Netlist::UNREACHED || (Gate::isSource(type) && type != GateType::INPUT)) {
+            src += "        v[" + std::to_string(g) + " * W + w] = 0;\n";
+        }
+    }
+    for (size_t seg = 0; seg < segmentCount; ++seg) src += "        segment" + std::to_string(seg) + "(v + w, W);\n";
+    src += "    }\n}\n";
+    return src;
+}
+
+bool NativeEvaluator::compile(const Netlist &netlist) {
+    unload();
+    error.clear();
+
+    if (!makeWorkDirectory(workDirectory)) {
+        error = "Could not create a build directory";
+        return false;
+    }
+    std::filesystem::path dir = workDirectory;
+    sourcePath = (dir / "circuit.cpp").string();
+    libraryPath = (dir / (std::string("circuit") + LIBRARY_EXTENSION)).string();
+    std::string logPath = (dir / "compile.log").string();
+
+    {
+        std::ofstream out(sourcePath);
+        out << emitSource(netlist);
+        if (!out) {
+            error = "Could not write " + sourcePath;
+            return false;
+        }
+    }
+
+    // $CXX may carry a launcher or flags ("ccache g++"), so the shell splits it as it would
+    const char *cxx = std::getenv("CXX");
+    std::string command = std::string(cxx && *cxx ? cxx : "c++") + " -O1 -shared -fPIC -o \"" + libraryPath + "\" \"" + sourcePath +
+                          "\" > \"" + logPath + "\" 2>&1";
+    int status = std::system(command.c_str());
+    std::string log = readFile(logPath);
+    if (status != 0) {
+        error = "Compiler failed: " + (log.empty() ? command : log);
+        return false;
+    }
+
+#ifdef _WIN32
+    HMODULE handle = LoadLibraryA(libraryPath.c_str());
+    library = handle;
+    if (handle) entry = reinterpret_cast<EntryPoint>(GetProcAddress(handle, ENTRY_SYMBOL));
+#else
+    library = dlopen(libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (library) entry = reinterpret_cast<EntryPoint>(dlsym(library, ENTRY_SYMBOL));
+#endif
+
+    if (!entry) {
+#ifdef _WIN32
+        error = "Could not load " + libraryPath;
+#else
+        const char *reason = dlerror();
+        error = "Could not load " + libraryPath + (reason ? std::string(": ") + reason : "");
+#endif
+        unload();
+        return false;
+    }
+    return true;
+}
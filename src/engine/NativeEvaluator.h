@@ -0,0 +1,42 @@
+// engine/NativeEvaluator.h
+
+#pragma once
+#include <string>
+
+#include "CircuitEvaluator.h"
+
+// Compiles a netlist to straight-line C++ (one bitwise statement per gate in
+// level order), builds it with the system compiler into a shared object and
+// loads it at runtime. The compiler is taken from $CXX, defaulting to "c++".
+// Each build lives in its own mkdtemp() directory.
+class NativeEvaluator : public CircuitEvaluator {
+   private:
+    using EntryPoint = void (*)(uint64_t *values, size_t words);
+
+    void *library = nullptr;
+    EntryPoint entry = nullptr;
+    std::string workDirectory;  // private to this user, removed with everything in it by unload()
+    std::string sourcePath;
+    std::string libraryPath;
+    std::string error;
+
+    void unload();
+
+   public:
+    static constexpr size_t SEGMENT_GATES = 256;  // gates per generated function
+
+    NativeEvaluator() = default;
+    NativeEvaluator(const NativeEvaluator &) = delete;
+    NativeEvaluator &operator=(const NativeEvaluator &) = delete;
+    ~NativeEvaluator() override;
+
+    // Emits, compiles and loads the evaluator; returns false and sets getError() on failure
+    bool compile(const Netlist &netlist);
+    bool isLoaded() const { return entry != nullptr; }
+    const std::string &getError() const { return error; }
+
+    const char *getName() const override { return "native"; }
+    void evaluate(std::vector<uint64_t> &values, size_t words) const override { entry(values.data(), words); }
+
+    static std::string emitSource(const Netlist &netlist);
+};
@@ -0,0 +1,391 @@
+// engine/Netlist.cpp
+
+#include "Netlist.h"
+
+#include <algorithm>
+
+namespace {
+
+// n-ary AND/OR/XOR (optionally inverted) folded pairwise over the pin blocks
+void applyNary(const PatternKernels &kernels, PatternOp op, bool invert, uint64_t *dst, const uint64_t *values, const uint32_t *pin,
+               const uint32_t *end, size_t words) {
+    size_t count = end - pin;
+    if (count == 0) {
+        std::fill_n(dst, words, invert ? ~uint64_t(0) : 0);
+    } else if (count == 1) {
+        kernels.unary(invert, dst, values + size_t(pin[0]) * words, words);
+    } else {
+        kernels.binary(op, invert && count == 2, dst, values + size_t(pin[0]) * words, values + size_t(pin[1]) * words, words);
+        for (size_t k = 2; k < count; ++k) {
+            kernels.binary(op, invert && k == count - 1, dst, dst, values + size_t(pin[k]) * words, words);
+        }
+    }
+}
+
+}  // namespace
+
+int Netlist::pinCount(GateType type) {
+    switch (type) {
+        case GateType::INPUT:
+        case GateType::CLOCK:
+            return 0;
+        case GateType::NOT:
+            return 1;
+        default:
+            return 2;
+    }
+}
+
+uint8_t Netlist::truthTable(GateType type) {
+    switch (type) {
+        case GateType::AND:
+            return 0b1000;
+        case GateType::OR:
+            return 0b1110;
+        case GateType::NAND:
+            return 0b0111;
+        case GateType::NOR:
+            return 0b0001;
+        case GateType::XOR:
+            return 0b0110;
+        case GateType::NOT:
+            return 0b0011;
+        case GateType::OUTPUT:
+            return 0b1100;
+        default:
+            return 0;
+    }
+}
+
+void Netlist::clear() {
+    types.clear();
+    faninStart.clear();
+    faninSrc.clear();
+    fanoutStart.clear();
+    fanoutDst.clear();
+    levels.clear();
+    order.clear();
+    levelStart.clear();
+    inputs.clear();
+    outputs.clear();
+    registers.clear();
+    clocks.clear();
+    levelQueues.clear();
+    queued.clear();
+    cycleOrder.clear();
+    componentStart.clear();
+    componentLoops.clear();
+}
+
+void Netlist::build(const std::vector<Gate> &gates, const std::vector<Wire> &wires) {
+    clear();
+    const uint32_t n = static_cast<uint32_t>(gates.size());
+
+    // Fan-in: one slot per pin, filled from the first wire that drives it
+    types.reserve(n);
+    faninStart.assign(n + 1, 0);
+    for (uint32_t i = 0; i < n; ++i) {
+        GateType type = gates[i].getType();
+        types.push_back(type);
+        faninStart[i + 1] = faninStart[i] + pinCount(type);
+        if (type == GateType::INPUT) inputs.push_back(i);
+        if (type == GateType::OUTPUT) outputs.push_back(i);
+        if (type == GateType::DFF || type == GateType::LATCH) registers.push_back(i);
+        if (type == GateType::CLOCK) clocks.push_back(i);
+    }
+
+    faninSrc.assign(faninStart[n], constZero());
+    std::vector<uint8_t> bound(faninSrc.size(), 0);
+    for (const auto &wire : wires) {
+        if (wire.getSrcGate() >= n || wire.getDstGate() >= n) continue;
+        uint32_t dst = static_cast<uint32_t>(wire.getDstGate());
+        int pin = wire.getDstPin();
+        if (pin < 0 || pin >= pinCount(types[dst])) continue;
+
+        uint32_t slot = faninStart[dst] + pin;
+        if (bound[slot]) continue;
+        faninSrc[slot] = static_cast<uint32_t>(wire.getSrcGate());
+        bound[slot] = 1;
+    }
+
+    // Fan-out: transpose of the connected fan-in slots
+    fanoutStart.assign(n + 1, 0);
+    for (uint32_t src : faninSrc) {
+        if (src != constZero()) fanoutStart[src + 1]++;
+    }
+    for (uint32_t i = 0; i < n; ++i) fanoutStart[i + 1] += fanoutStart[i];
+
+    fanoutDst.resize(fanoutStart[n]);
+    std::vector<uint32_t> cursor(fanoutStart.begin(), fanoutStart.end() - 1);
+    for (uint32_t g = 0; g < n; ++g) {
+        for (const uint32_t *pin = faninBegin(g); pin != faninEnd(g); ++pin) {
+            if (*pin != constZero()) fanoutDst[cursor[*pin]++] = g;
+        }
+    }
+
+    // Levelize (Kahn); gates that never become ready sit on or behind a cycle. Sources do not
+    // wait for their pins, so loops through a register are not combinational loops.
+    levels.assign(n, UNREACHED);
+    std::vector<uint32_t> pending(n, 0);
+    std::vector<uint32_t> ready;
+    ready.reserve(n);
+    for (uint32_t g = 0; g < n; ++g) {
+        if (!Gate::isSource(types[g])) {
+            for (const uint32_t *pin = faninBegin(g); pin != faninEnd(g); ++pin) {
+                if (*pin != constZero()) pending[g]++;
+            }
+        }
+        if (pending[g] == 0) {
+            levels[g] = 0;
+            ready.push_back(g);
+        }
+    }
+
+    uint32_t maxLevel = 0;
+    for (size_t head = 0; head < ready.size(); ++head) {
+        uint32_t g = ready[head];
+        for (const uint32_t *dst = fanoutBegin(g); dst != fanoutEnd(g); ++dst) {
+            if (Gate::isSource(types[*dst]) || --pending[*dst] != 0) continue;
+
+            uint32_t level = 0;
+            for (const uint32_t *pin = faninBegin(*dst); pin != faninEnd(*dst); ++pin) {
+                if (*pin != constZero()) level = std::max(level, levels[*pin] + 1);
+            }
+            levels[*dst] = level;
+            maxLevel = std::max(maxLevel, level);
+            ready.push_back(*dst);
+        }
+    }
+
+    if (ready.size() != n) findComponents();
+
+    // Bucket the ready gates by level
+    if (ready.empty()) return;
+    levelStart.assign(maxLevel + 2, 0);
+    for (uint32_t g : ready) levelStart[levels[g] + 1]++;
+    for (uint32_t l = 0; l <= maxLevel; ++l) levelStart[l + 1] += levelStart[l];
+
+    order.resize(ready.size());
+    cursor.assign(levelStart.begin(), levelStart.end() - 1);
+    for (uint32_t g = 0; g < n; ++g) {
+        if (levels[g] != UNREACHED) order[cursor[levels[g]]++] = g;
+    }
+
+    // Size every bucket for its whole level so propagation never allocates
+    levelQueues.resize(levelCount());
+    for (size_t l = 0; l < levelCount(); ++l) levelQueues[l].reserve(levelStart[l + 1] - levelStart[l]);
+    queued.assign(n, 0);
+}
+
+void Netlist::findComponents() {
+    // Iterative Tarjan over the gates Kahn could not order. Their fan-out is unordered too,
+    // and components complete sinks first, so they are laid out in reverse.
+    const uint32_t n = static_cast<uint32_t>(types.size());
+    std::vector<uint32_t> index(n, UNREACHED), low(n, 0);
+    std::vector<uint8_t> onStack(n, 0);
+    std::vector<uint32_t> stack;
+    std::vector<std::pair<uint32_t, const uint32_t *>> frames;  // gate and next fan-out to visit
+    std::vector<uint32_t> members;                              // completed components, sinks first
+    std::vector<uint32_t> memberStart{0};
+    uint32_t counter = 0;
+
+    auto visit = [&](uint32_t g) {
+        index[g] = low[g] = counter++;
+        stack.push_back(g);
+        onStack[g] = 1;
+        frames.push_back({g, fanoutBegin(g)});
+    };
+    for (uint32_t root = 0; root < n; ++root) {
+        if (levels[root] != UNREACHED || index[root] != UNREACHED) continue;
+        visit(root);
+        while (!frames.empty()) {
+            const uint32_t g = frames.back().first;
+            if (frames.back().second != fanoutEnd(g)) {
+                uint32_t w = *frames.back().second++;
+                if (levels[w] != UNREACHED) continue;  // a source fed from the loop
+                if (index[w] == UNREACHED) {
+                    visit(w);
+                } else if (onStack[w]) {
+                    low[g] = std::min(low[g], index[w]);
+                }
+                continue;
+            }
+
+            frames.pop_back();
+            if (!frames.empty()) low[frames.back().first] = std::min(low[frames.back().first], low[g]);
+            if (low[g] != index[g]) continue;
+            uint32_t w;
+            do {
+                w = stack.back();
+                stack.pop_back();
+                onStack[w] = 0;
+                members.push_back(w);
+            } while (w != g);
+            memberStart.push_back(static_cast<uint32_t>(members.size()));
+        }
+    }
+
+    cycleOrder.reserve(members.size());
+    componentStart.assign(1, 0);
+    for (size_t c = memberStart.size() - 1; c-- > 0;) {
+        const uint32_t *begin = members.data() + memberStart[c];
+        const uint32_t *end = members.data() + memberStart[c + 1];
+        cycleOrder.insert(cycleOrder.end(), begin, end);
+        componentStart.push_back(static_cast<uint32_t>(cycleOrder.size()));
+        componentLoops.push_back(end - begin > 1 || std::find(faninBegin(*begin), faninEnd(*begin), *begin) != faninEnd(*begin));
+    }
+}
+
+CycleState Netlist::evaluate(std::vector<uint8_t> &values) const {
+    values[constZero()] = 0;
+    for (uint32_t g : order) {
+        if (!Gate::isSource(types[g])) values[g] = evaluateGate(g, values);
+    }
+    return hasCycles() ? solveCycles(values) : CycleState::STABLE;
+}
+
+CycleState Netlist::solveCycles(std::vector<uint8_t> &values, std::vector<uint32_t> *changed) const {
+    CycleState worst = CycleState::STABLE;
+    for (size_t c = 0; c < componentLoops.size(); ++c) {
+        const uint32_t *begin = cycleOrder.data() + componentStart[c];
+        const uint32_t *end = cycleOrder.data() + componentStart[c + 1];
+        if (componentLoops[c]) {
+            worst = std::max(worst, settleLoop(begin, end, values, changed));
+            continue;
+        }
+        uint8_t v = evaluateGate(*begin, values);
+        if (v == values[*begin]) continue;
+        values[*begin] = v;
+        if (changed) changed->push_back(*begin);
+    }
+    return worst;
+}
+
+CycleState Netlist::settleLoop(const uint32_t *begin, const uint32_t *end, std::vector<uint8_t> &values, std::vector<uint32_t> *changed) const {
+    // States seen after each sweep, starting with the incoming one; a hash match is confirmed
+    // against the stored state before calling it a repeat
+    const size_t size = end - begin;
+    std::vector<uint64_t> hashes;
+    std::vector<uint8_t> history;
+    auto record = [&]() {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (const uint32_t *g = begin; g != end; ++g) hash = (hash ^ values[*g]) * 0x100000001b3ull;
+        for (size_t k = 0; k < hashes.size(); ++k) {
+            if (hashes[k] != hash) continue;
+            const uint8_t *state = history.data() + k * size;
+            if (std::equal(begin, end, state, [&](uint32_t g, uint8_t v) { return values[g] == v; })) return false;
+        }
+        hashes.push_back(hash);
+        for (const uint32_t *g = begin; g != end; ++g) history.push_back(values[*g]);
+        return true;
+    };
+
+    record();
+    for (size_t sweep = 0; sweep < MAX_LOOP_SWEEPS; ++sweep) {
+        bool moved = false;
+        for (const uint32_t *g = begin; g != end; ++g) {
+            uint8_t v = evaluateGate(*g, values);
+            if (v == values[*g]) continue;
+            values[*g] = v;
+            moved = true;
+            if (changed) changed->push_back(*g);
+        }
+        if (!moved) return CycleState::STABLE;
+        if (!record()) return CycleState::OSCILLATING;
+    }
+    return CycleState::UNRESOLVED;
+}
+
+void Netlist::evaluatePatterns(std::vector<uint64_t> &values, size_t words, const PatternKernels &kernels) const {
+    uint64_t *data = values.data();
+    std::fill_n(data + size_t(constZero()) * words, words, 0);
+
+    if (order.size() != types.size()) {
+        for (uint32_t g = 0; g < types.size(); ++g) {
+            if (levels[g] == UNREACHED) std::fill_n(data + size_t(g) * words, words, 0);
+        }
+    }
+
+    for (uint32_t g : order) {
+        uint64_t *dst = data + size_t(g) * words;
+        const uint32_t *pin = faninBegin(g);
+        const uint32_t *end = faninEnd(g);
+
+        switch (types[g]) {
+            case GateType::INPUT:
+                break;
+            case GateType::CLOCK:
+            case GateType::DFF:
+            case GateType::LATCH:
+                std::fill_n(dst, words, 0);
+                break;
+            case GateType::AND:
+                applyNary(kernels, PatternOp::AND, false, dst, data, pin, end, words);
+                break;
+            case GateType::NAND:
+                applyNary(kernels, PatternOp::AND, true, dst, data, pin, end, words);
+                break;
+            case GateType::OR:
+                applyNary(kernels, PatternOp::OR, false, dst, data, pin, end, words);
+                break;
+            case GateType::NOR:
+                applyNary(kernels, PatternOp::OR, true, dst, data, pin, end, words);
+                break;
+            case GateType::XOR:
+                applyNary(kernels, PatternOp::XOR, false, dst, data, pin, end, words);
+                break;
+            case GateType::NOT:
+                kernels.unary(true, dst, data + size_t(*pin) * words, words);
+                break;
+            case GateType::OUTPUT:
+                kernels.unary(false, dst, data + size_t(*pin) * words, words);
+                break;
+        }
+    }
+}
+
+uint64_t Netlist::inputPattern(size_t input, uint64_t base) {
+    static const uint64_t lowPatterns[6] = {0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+                                            0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+    if (input < 6) return lowPatterns[input];
+    if (input >= 64) return 0;
+    return ((base >> input) & 1) ? ~uint64_t(0) : 0;
+}
+
+uint8_t Netlist::evaluateGate(uint32_t gate, const std::vector<uint8_t> &values) const {
+    if (Gate::isSource(types[gate])) return values[gate];
+    return Gate::evaluateSignals(types[gate], values.data(), faninBegin(gate), faninEnd(gate));
+}
+
+void Netlist::schedule(uint32_t gate) {
+    // Gates behind a cycle are never evaluated and sources hold their value, so neither enters the queue
+    if (queued[gate] || levels[gate] == UNREACHED || Gate::isSource(types[gate])) return;
+    queued[gate] = 1;
+    levelQueues[levels[gate]].push_back(gate);
+}
+
+size_t Netlist::propagate(std::vector<uint8_t> &values, uint32_t source, std::vector<uint32_t> &changed) {
+    if (source >= gateCount() || levels[source] == UNREACHED) return 0;
+
+    for (const uint32_t *dst = fanoutBegin(source); dst != fanoutEnd(source); ++dst) schedule(*dst);
+
+    // Fan-out always sits on a higher level, so draining the buckets in level order visits every gate once
+    size_t evaluated = 0;
+    for (size_t level = levels[source] + 1; level < levelQueues.size(); ++level) {
+        auto &bucket = levelQueues[level];
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            uint32_t g = bucket[i];
+            queued[g] = 0;
+            evaluated++;
+
+            uint8_t v = evaluateGate(g, values);
+            if (v == values[g]) continue;
+
+            values[g] = v;
+            changed.push_back(g);
+            for (const uint32_t *dst = fanoutBegin(g); dst != fanoutEnd(g); ++dst) schedule(*dst);
+        }
+        bucket.clear();
+    }
+    return evaluated;
+}
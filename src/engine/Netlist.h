@@ -0,0 +1,111 @@
+// engine/Netlist.h
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Gate.h"
+#include "PatternKernels.h"
+#include "Wire.h"
+
+// Outcome of settling the combinational loops of a circuit, worst first
+enum class CycleState : uint8_t { STABLE, OSCILLATING, UNRESOLVED };
+
+// Compiled, levelized view of the circuit built from Simulator::gates/wires.
+// Fan-in and fan-out are stored as CSR arrays and gates are kept in
+// topological (level) order so a full evaluation is a single linear pass.
+// Sources (Gate::isSource) sit on level 0 whatever drives their pins: an
+// evaluation reads clocks and registers like inputs, and their pins are only
+// looked at when a CycleSimulation updates the registers.
+class Netlist {
+   private:
+    std::vector<GateType> types;
+    std::vector<uint32_t> faninStart;   // size = gateCount + 1
+    std::vector<uint32_t> faninSrc;     // one slot per input pin, unconnected pins point at constZero()
+    std::vector<uint32_t> fanoutStart;  // size = gateCount + 1
+    std::vector<uint32_t> fanoutDst;
+    std::vector<uint32_t> levels;      // level per gate, UNREACHED for gates stuck behind a cycle
+    std::vector<uint32_t> order;       // evaluable gates sorted by level
+    std::vector<uint32_t> levelStart;  // offsets into order, size = levelCount + 1
+    std::vector<uint32_t> inputs;
+    std::vector<uint32_t> outputs;
+    std::vector<uint32_t> registers;  // DFF and LATCH gates
+    std::vector<uint32_t> clocks;
+
+    // Gates on or behind a cycle, grouped by strongly connected component with the components in
+    // topological order. A component is a loop if it has several gates or feeds itself.
+    std::vector<uint32_t> cycleOrder;
+    std::vector<uint32_t> componentStart;  // offsets into cycleOrder, size = componentCount + 1
+    std::vector<uint8_t> componentLoops;
+
+    // Change queue for event-driven propagation, one bucket per level
+    std::vector<std::vector<uint32_t>> levelQueues;
+    std::vector<uint8_t> queued;
+
+    uint8_t evaluateGate(uint32_t gate, const std::vector<uint8_t> &values) const;
+    void schedule(uint32_t gate);
+    void findComponents();
+    CycleState settleLoop(const uint32_t *begin, const uint32_t *end, std::vector<uint8_t> &values, std::vector<uint32_t> *changed) const;
+
+   public:
+    static constexpr uint32_t UNREACHED = 0xFFFFFFFFu;
+    static constexpr size_t MAX_LOOP_SWEEPS = 64;  // fixpoint sweeps per loop before giving up
+
+    // Number of input pins the evaluator looks at for a gate type
+    static int pinCount(GateType type);
+
+    // Output of a gate for pin values (a, b) at bit a * 2 + b; NOT and OUTPUT only look at a
+    static uint8_t truthTable(GateType type);
+
+    void build(const std::vector<Gate> &gates, const std::vector<Wire> &wires);
+    void clear();
+
+    // values must hold signalCount() entries; sources are read, all other gates are written.
+    // Gates on a cycle start from their values in `values` and are settled by solveCycles().
+    CycleState evaluate(std::vector<uint8_t> &values) const;
+
+    // Settles the gates on or behind a cycle, assuming the levelized gates are up to date.
+    // Each loop is swept in place until no gate changes (STABLE), a state repeats
+    // (OSCILLATING) or MAX_LOOP_SWEEPS run out (UNRESOLVED); gates behind a loop are
+    // evaluated once. Gates whose value changed are appended to changed if given.
+    CycleState solveCycles(std::vector<uint8_t> &values, std::vector<uint32_t> *changed = nullptr) const;
+
+    // Pattern-parallel variant: every signal is a block of `words` consecutive uint64_t
+    // (signal s starts at values[s * words]), evaluated gate by gate with SIMD kernels.
+    // Reads 0 for every gate on or behind a cycle and for clocks and registers, which is
+    // their reset state.
+    void evaluatePatterns(std::vector<uint64_t> &values, size_t words, const PatternKernels &kernels = getPatternKernels()) const;
+
+    // Word for input number `input` covering the 64 consecutive combinations starting at `base`
+    // (base must be a multiple of 64), where bit `input` of a combination is that input's value.
+    static uint64_t inputPattern(size_t input, uint64_t base);
+
+    // Re-evaluates only the fan-out cone of a gate whose value in values was changed by the caller,
+    // stopping at gates whose output did not change. Every gate that flipped is appended to changed.
+    // values must be consistent with a previous evaluate()/propagate() apart from that gate.
+    // Only levelized gates are visited; loops are settled afterwards with solveCycles().
+    size_t propagate(std::vector<uint8_t> &values, uint32_t source, std::vector<uint32_t> &changed);
+
+    size_t gateCount() const { return types.size(); }
+    size_t signalCount() const { return types.size() + 1; }
+    uint32_t constZero() const { return static_cast<uint32_t>(types.size()); }
+
+    GateType getType(uint32_t gate) const { return types[gate]; }
+    const uint32_t *faninBegin(uint32_t gate) const { return faninSrc.data() + faninStart[gate]; }
+    const uint32_t *faninEnd(uint32_t gate) const { return faninSrc.data() + faninStart[gate + 1]; }
+    const uint32_t *fanoutBegin(uint32_t gate) const { return fanoutDst.data() + fanoutStart[gate]; }
+    const uint32_t *fanoutEnd(uint32_t gate) const { return fanoutDst.data() + fanoutStart[gate + 1]; }
+
+    uint32_t getLevel(uint32_t gate) const { return levels[gate]; }
+    bool hasCycles() const { return !cycleOrder.empty(); }
+    size_t loopCount() const { return std::count(componentLoops.begin(), componentLoops.end(), 1); }
+    size_t levelCount() const { return levelStart.empty() ? 0 : levelStart.size() - 1; }
+    const std::vector<uint32_t> &getOrder() const { return order; }
+    const std::vector<uint32_t> &getLevelStart() const { return levelStart; }
+    const std::vector<uint32_t> &getInputs() const { return inputs; }
+    const std::vector<uint32_t> &getOutputs() const { return outputs; }
+    const std::vector<uint32_t> &getRegisters() const { return registers; }
+    const std::vector<uint32_t> &getClocks() const { return clocks; }
+    bool isSequential() const { return !registers.empty() || !clocks.empty(); }
+};
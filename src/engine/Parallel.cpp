@@ -0,0 +1,114 @@
+// engine/Parallel.cpp
+
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Body = std::function<void(size_t begin, size_t end, size_t worker)>;
+
+// parallelWorkerCount() - 1 threads started on first use and parked on a condition variable
+// between loops; the thread calling parallelFor() works as worker 0
+class WorkerPool {
+   public:
+    static WorkerPool &instance() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &t : threads) t.join();
+    }
+
+    // Returns false without running anything if the pool is already busy with another loop,
+    // e.g. a nested parallelFor() or one from a second thread
+    bool run(size_t count, size_t chunkSize, const Body &fn) {
+        std::unique_lock<std::mutex> owner(busy, std::try_to_lock);
+        if (!owner) return false;
+
+        const size_t chunks = (count + chunkSize - 1) / chunkSize;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (threads.empty()) {
+                for (size_t w = 1; w < parallelWorkerCount(); ++w) threads.emplace_back(&WorkerPool::work, this, w);
+            }
+            body = &fn;
+            total = count;
+            size = chunkSize;
+            chunkCount = chunks;
+            next = 0;
+            workers = std::min(parallelWorkerCount(), chunks);
+            active = workers - 1;
+            ++generation;
+        }
+        wake.notify_all();
+        runChunks(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return active == 0; });
+        body = nullptr;
+        return true;
+    }
+
+   private:
+    std::mutex busy;   // held by the parallelFor() that owns the pool
+    std::mutex mutex;  // guards the loop description and the counters below
+    std::condition_variable wake, done;
+    std::vector<std::thread> threads;
+    uint64_t generation = 0;
+    bool stopping = false;
+
+    const Body *body = nullptr;
+    size_t total = 0, size = 0, chunkCount = 0;
+    size_t workers = 0;  // workers taking part in the current loop, the caller included
+    size_t active = 0;   // pool threads still working on it
+    std::atomic<size_t> next{0};
+
+    // Workers pull chunks from a shared counter so uneven chunks still balance
+    void runChunks(size_t worker) {
+        for (size_t chunk = next++; chunk < chunkCount; chunk = next++) {
+            size_t begin = chunk * size;
+            (*body)(begin, std::min(total, begin + size), worker);
+        }
+    }
+
+    void work(size_t worker) {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            if (worker >= workers) continue;
+
+            lock.unlock();
+            runChunks(worker);
+            lock.lock();
+            if (--active == 0) done.notify_one();
+        }
+    }
+};
+
+}  // namespace
+
+size_t parallelWorkerCount() { return std::max(1u, std::thread::hardware_concurrency()); }
+
+void parallelFor(size_t count, size_t chunkSize, const std::function<void(size_t begin, size_t end, size_t worker)> &fn) {
+    if (count == 0) return;
+    chunkSize = std::max<size_t>(1, chunkSize);
+
+    // A single chunk or a busy pool runs on the calling thread as worker 0
+    if ((count + chunkSize - 1) / chunkSize > 1 && parallelWorkerCount() > 1 && WorkerPool::instance().run(count, chunkSize, fn)) return;
+    for (size_t begin = 0; begin < count; begin += chunkSize) fn(begin, std::min(count, begin + chunkSize), 0);
+}
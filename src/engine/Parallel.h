@@ -0,0 +1,15 @@
+// engine/Parallel.h
+
+#pragma once
+#include <cstddef>
+#include <functional>
+
+// Number of threads parallelFor() runs on (hardware concurrency, at least 1)
+size_t parallelWorkerCount();
+
+// Splits [0, count) into chunks of chunkSize and hands them to a pool of worker threads
+// that is started once and reused by every call. fn(begin, end, worker) is called once per
+// chunk; worker < parallelWorkerCount() identifies the calling thread so callers can keep
+// per-worker scratch state. Blocks until all chunks ran. While the pool is busy (a nested
+// call, or one from another thread) the chunks run on the calling thread as worker 0.
+void parallelFor(size_t count, size_t chunkSize, const std::function<void(size_t begin, size_t end, size_t worker)> &fn);
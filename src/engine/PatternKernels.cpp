@@ -0,0 +1,145 @@
+// engine/PatternKernels.cpp
+
+#include "PatternKernels.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PATTERN_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// =================== SCALAR =================== //
+void binaryScalar(PatternOp op, bool invert, uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t words) {
+    const uint64_t mask = invert ? ~uint64_t(0) : 0;
+    switch (op) {
+        case PatternOp::AND:
+            for (size_t i = 0; i < words; ++i) dst[i] = (a[i] & b[i]) ^ mask;
+            break;
+        case PatternOp::OR:
+            for (size_t i = 0; i < words; ++i) dst[i] = (a[i] | b[i]) ^ mask;
+            break;
+        case PatternOp::XOR:
+            for (size_t i = 0; i < words; ++i) dst[i] = (a[i] ^ b[i]) ^ mask;
+            break;
+    }
+}
+
+void unaryScalar(bool invert, uint64_t *dst, const uint64_t *a, size_t words) {
+    const uint64_t mask = invert ? ~uint64_t(0) : 0;
+    for (size_t i = 0; i < words; ++i) dst[i] = a[i] ^ mask;
+}
+
+const PatternKernels SCALAR_KERNELS = {"scalar", binaryScalar, unaryScalar};
+
+#ifdef PATTERN_KERNELS_X86
+
+// =================== AVX2 (256 patterns per instruction) =================== //
+__attribute__((target("avx2"))) void binaryAvx2(PatternOp op, bool invert, uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t words) {
+    const __m256i mask = _mm256_set1_epi64x(invert ? -1 : 0);
+    size_t i = 0;
+    switch (op) {
+        case PatternOp::AND:
+            for (; i + 4 <= words; i += 4) {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_xor_si256(_mm256_and_si256(x, y), mask));
+            }
+            break;
+        case PatternOp::OR:
+            for (; i + 4 <= words; i += 4) {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_xor_si256(_mm256_or_si256(x, y), mask));
+            }
+            break;
+        case PatternOp::XOR:
+            for (; i + 4 <= words; i += 4) {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_xor_si256(_mm256_xor_si256(x, y), mask));
+            }
+            break;
+    }
+    binaryScalar(op, invert, dst + i, a + i, b + i, words - i);
+}
+
+__attribute__((target("avx2"))) void unaryAvx2(bool invert, uint64_t *dst, const uint64_t *a, size_t words) {
+    const __m256i mask = _mm256_set1_epi64x(invert ? -1 : 0);
+    size_t i = 0;
+    for (; i + 4 <= words; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_xor_si256(x, mask));
+    }
+    unaryScalar(invert, dst + i, a + i, words - i);
+}
+
+const PatternKernels AVX2_KERNELS = {"avx2", binaryAvx2, unaryAvx2};
+
+// =================== AVX-512 (512 patterns per instruction) =================== //
+__attribute__((target("avx512f"))) void binaryAvx512(PatternOp op, bool invert, uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t words) {
+    const __m512i mask = _mm512_set1_epi64(invert ? -1 : 0);
+    size_t i = 0;
+    switch (op) {
+        case PatternOp::AND:
+            for (; i + 8 <= words; i += 8) {
+                __m512i x = _mm512_loadu_si512(a + i);
+                __m512i y = _mm512_loadu_si512(b + i);
+                _mm512_storeu_si512(dst + i, _mm512_xor_si512(_mm512_and_si512(x, y), mask));
+            }
+            break;
+        case PatternOp::OR:
+            for (; i + 8 <= words; i += 8) {
+                __m512i x = _mm512_loadu_si512(a + i);
+                __m512i y = _mm512_loadu_si512(b + i);
+                _mm512_storeu_si512(dst + i, _mm512_xor_si512(_mm512_or_si512(x, y), mask));
+            }
+            break;
+        case PatternOp::XOR:
+            for (; i + 8 <= words; i += 8) {
+                __m512i x = _mm512_loadu_si512(a + i);
+                __m512i y = _mm512_loadu_si512(b + i);
+                _mm512_storeu_si512(dst + i, _mm512_xor_si512(_mm512_xor_si512(x, y), mask));
+            }
+            break;
+    }
+    binaryScalar(op, invert, dst + i, a + i, b + i, words - i);
+}
+
+__attribute__((target("avx512f"))) void unaryAvx512(bool invert, uint64_t *dst, const uint64_t *a, size_t words) {
+    const __m512i mask = _mm512_set1_epi64(invert ? -1 : 0);
+    size_t i = 0;
+    for (; i + 8 <= words; i += 8) {
+        _mm512_storeu_si512(dst + i, _mm512_xor_si512(_mm512_loadu_si512(a + i), mask));
+    }
+    unaryScalar(invert, dst + i, a + i, words - i);
+}
+
+const PatternKernels AVX512_KERNELS = {"avx512", binaryAvx512, unaryAvx512};
+
+#endif
+
+}  // namespace
+
+PatternIsa detectPatternIsa() {
+#ifdef PATTERN_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return PatternIsa::AVX512;
+    if (__builtin_cpu_supports("avx2")) return PatternIsa::AVX2;
+#endif
+    return PatternIsa::SCALAR;
+}
+
+const PatternKernels &getPatternKernels(PatternIsa isa) {
+#ifdef PATTERN_KERNELS_X86
+    PatternIsa supported = detectPatternIsa();
+    if (isa == PatternIsa::AVX512 && supported == PatternIsa::AVX512) return AVX512_KERNELS;
+    if (isa == PatternIsa::AVX2 && supported != PatternIsa::SCALAR) return AVX2_KERNELS;
+#endif
+    return SCALAR_KERNELS;
+}
+
+const PatternKernels &getPatternKernels() {
+    static const PatternKernels &kernels = getPatternKernels(detectPatternIsa());
+    return kernels;
+}
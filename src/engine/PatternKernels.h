@@ -0,0 +1,28 @@
+// engine/PatternKernels.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Word-block kernels for pattern-parallel evaluation. A signal is a block of
+// `words` uint64_t, i.e. 64 * words input patterns; one kernel call evaluates
+// one gate operation over the whole block.
+enum class PatternOp { AND, OR, XOR };
+enum class PatternIsa { SCALAR, AVX2, AVX512 };
+
+struct PatternKernels {
+    const char *name;
+    // dst = (a op b) ^ (invert ? ~0 : 0); dst may alias a or b
+    void (*binary)(PatternOp op, bool invert, uint64_t *dst, const uint64_t *a, const uint64_t *b, size_t words);
+    // dst = a ^ (invert ? ~0 : 0); dst may alias a
+    void (*unary)(bool invert, uint64_t *dst, const uint64_t *a, size_t words);
+};
+
+// Widest instruction set the running CPU supports
+PatternIsa detectPatternIsa();
+
+// Kernels for a given instruction set; falls back to scalar when it is not compiled in or not supported
+const PatternKernels &getPatternKernels(PatternIsa isa);
+
+// Kernels for detectPatternIsa(), resolved once
+const PatternKernels &getPatternKernels();
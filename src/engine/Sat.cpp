@@ -0,0 +1,367 @@
+// engine/Sat.cpp
+
+#include "Sat.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr Literal NO_LITERAL = 0xFFFFFFFFu;
+constexpr size_t RESTART_CONFLICTS = 100;  // scaled by the Luby sequence
+constexpr double ACTIVITY_DECAY = 0.95;
+
+// 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+size_t luby(size_t i) {
+    size_t size = 1, exponent = 0;
+    while (size < i + 1) {
+        ++exponent;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != i) {
+        size = (size - 1) >> 1;
+        --exponent;
+        i %= size;
+    }
+    return size_t(1) << exponent;
+}
+
+}  // namespace
+
+uint32_t SatSolver::newVariable() {
+    uint32_t var = static_cast<uint32_t>(assigns.size());
+    assigns.push_back(UNASSIGNED);
+    savedPhase.push_back(0);
+    reasons.push_back(NO_REASON);
+    levels.push_back(0);
+    activity.push_back(0.0);
+    heapIndex.push_back(NO_REASON);
+    seen.push_back(0);
+    watches.emplace_back();
+    watches.emplace_back();
+    heapInsert(var);
+    return var;
+}
+
+bool SatSolver::addClause(std::vector<Literal> literals) {
+    if (unsatisfiable) return false;
+    backtrack(0);
+
+    std::sort(literals.begin(), literals.end());
+    literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+    size_t kept = 0;
+    for (size_t i = 0; i < literals.size(); ++i) {
+        Literal lit = literals[i];
+        // Tautology or already satisfied at the top level
+        if (value(lit) == 1 || (i + 1 < literals.size() && literals[i + 1] == negateLiteral(lit))) return true;
+        if (value(lit) == UNASSIGNED) literals[kept++] = lit;
+    }
+    literals.resize(kept);
+
+    if (literals.empty()) {
+        unsatisfiable = true;
+    } else if (literals.size() == 1) {
+        assign(literals[0], NO_REASON);
+        unsatisfiable = propagate() != NO_REASON;
+    } else {
+        clauses.push_back({std::move(literals), false, false, 0});
+        attach(static_cast<uint32_t>(clauses.size() - 1));
+    }
+    return !unsatisfiable;
+}
+
+SatResult SatSolver::solve(std::chrono::milliseconds budget) {
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    model.clear();
+    if (unsatisfiable) return SatResult::UNSATISFIABLE;
+    backtrack(0);
+    if (propagate() != NO_REASON) {
+        unsatisfiable = true;
+        return SatResult::UNSATISFIABLE;
+    }
+
+    size_t maxLearnts = clauses.size() / 3 + 1000;
+    std::vector<Literal> learnt;
+    for (size_t restart = 0;; ++restart) {
+        const size_t restartLimit = luby(restart) * RESTART_CONFLICTS;
+        for (size_t restartConflicts = 0;;) {
+            uint32_t conflict = propagate();
+            if (conflict != NO_REASON) {
+                ++conflicts;
+                ++restartConflicts;
+                if (decisionLevel() == 0) {
+                    unsatisfiable = true;
+                    return SatResult::UNSATISFIABLE;
+                }
+
+                uint32_t backtrackLevel;
+                analyze(conflict, learnt, backtrackLevel);
+
+                // Literal block distance: decision levels the clause spans
+                learntLevels.clear();
+                for (Literal lit : learnt) learntLevels.push_back(levels[literalVar(lit)]);
+                std::sort(learntLevels.begin(), learntLevels.end());
+                uint32_t lbd = static_cast<uint32_t>(std::unique(learntLevels.begin(), learntLevels.end()) - learntLevels.begin());
+
+                backtrack(backtrackLevel);
+                if (learnt.size() == 1) {
+                    assign(learnt[0], NO_REASON);
+                } else {
+                    clauses.push_back({learnt, true, false, lbd});
+                    uint32_t index = static_cast<uint32_t>(clauses.size() - 1);
+                    attach(index);
+                    assign(learnt[0], index);
+                    ++learntCount;
+                }
+                activityIncrement /= ACTIVITY_DECAY;
+
+                if ((conflicts & 255) == 0 && std::chrono::steady_clock::now() >= deadline) {
+                    backtrack(0);
+                    return SatResult::UNKNOWN;
+                }
+                continue;
+            }
+
+            if (restartConflicts >= restartLimit) {
+                backtrack(0);
+                if (learntCount > maxLearnts) {
+                    reduceLearnts();
+                    maxLearnts += maxLearnts / 10;
+                }
+                break;
+            }
+
+            Literal next = pickBranch();
+            if (next == NO_LITERAL) {
+                model = assigns;
+                return SatResult::SATISFIABLE;
+            }
+            trailLimits.push_back(trail.size());
+            assign(next, NO_REASON);
+        }
+    }
+}
+
+void SatSolver::assign(Literal lit, uint32_t reason) {
+    uint32_t var = literalVar(lit);
+    assigns[var] = (lit & 1) ? 0 : 1;
+    reasons[var] = reason;
+    levels[var] = decisionLevel();
+    trail.push_back(lit);
+}
+
+void SatSolver::attach(uint32_t clause) {
+    const std::vector<Literal> &literals = clauses[clause].literals;
+    watches[negateLiteral(literals[0])].push_back({clause, literals[1]});
+    watches[negateLiteral(literals[1])].push_back({clause, literals[0]});
+}
+
+uint32_t SatSolver::propagate() {
+    while (propagateHead < trail.size()) {
+        const Literal p = trail[propagateHead++];
+        const Literal falseLit = negateLiteral(p);
+        std::vector<Watcher> &list = watches[p];
+
+        size_t i = 0, j = 0;
+        while (i < list.size()) {
+            const Watcher watcher = list[i++];
+            if (value(watcher.blocker) == 1) {
+                list[j++] = watcher;
+                continue;
+            }
+
+            // Keep the false literal in slot 1
+            std::vector<Literal> &literals = clauses[watcher.clause].literals;
+            if (literals[0] == falseLit) std::swap(literals[0], literals[1]);
+            const Literal first = literals[0];
+            const Watcher kept{watcher.clause, first};
+            if (first != watcher.blocker && value(first) == 1) {
+                list[j++] = kept;
+                continue;
+            }
+
+            bool moved = false;
+            for (size_t k = 2; k < literals.size(); ++k) {
+                if (value(literals[k]) == 0) continue;
+                literals[1] = literals[k];
+                literals[k] = falseLit;
+                watches[negateLiteral(literals[1])].push_back(kept);
+                moved = true;
+                break;
+            }
+            if (moved) continue;
+
+            // Unit or conflicting
+            list[j++] = kept;
+            if (value(first) == 0) {
+                while (i < list.size()) list[j++] = list[i++];
+                list.resize(j);
+                propagateHead = trail.size();
+                return watcher.clause;
+            }
+            assign(first, watcher.clause);
+        }
+        list.resize(j);
+    }
+    return NO_REASON;
+}
+
+void SatSolver::analyze(uint32_t conflict, std::vector<Literal> &learnt, uint32_t &backtrackLevel) {
+    // Walk the trail back from the conflict until one literal of the current level is left
+    learnt.assign(1, NO_LITERAL);
+    size_t pending = 0;
+    Literal p = NO_LITERAL;
+    size_t index = trail.size();
+    uint32_t clause = conflict;
+    do {
+        const std::vector<Literal> &literals = clauses[clause].literals;
+        for (size_t k = p == NO_LITERAL ? 0 : 1; k < literals.size(); ++k) {
+            const uint32_t var = literalVar(literals[k]);
+            if (seen[var] || levels[var] == 0) continue;
+            seen[var] = 1;
+            bumpActivity(var);
+            if (levels[var] >= decisionLevel()) {
+                ++pending;
+            } else {
+                learnt.push_back(literals[k]);
+            }
+        }
+        while (!seen[literalVar(trail[--index])]) {
+        }
+        p = trail[index];
+        clause = reasons[literalVar(p)];
+        seen[literalVar(p)] = 0;
+        --pending;
+    } while (pending > 0);
+    learnt[0] = negateLiteral(p);
+
+    // Drop literals implied by the rest of the clause
+    const std::vector<Literal> original = learnt;
+    size_t kept = 1;
+    for (size_t k = 1; k < learnt.size(); ++k) {
+        if (!redundant(learnt[k])) learnt[kept++] = learnt[k];
+    }
+    learnt.resize(kept);
+    for (Literal lit : original) seen[literalVar(lit)] = 0;
+
+    // The highest remaining level goes to slot 1 so it is watched
+    backtrackLevel = 0;
+    for (size_t k = 1; k < learnt.size(); ++k) {
+        if (levels[literalVar(learnt[k])] > backtrackLevel) {
+            backtrackLevel = levels[literalVar(learnt[k])];
+            std::swap(learnt[1], learnt[k]);
+        }
+    }
+}
+
+bool SatSolver::redundant(Literal lit) const {
+    uint32_t reason = reasons[literalVar(lit)];
+    if (reason == NO_REASON) return false;
+    const std::vector<Literal> &literals = clauses[reason].literals;
+    for (size_t k = 1; k < literals.size(); ++k) {
+        uint32_t var = literalVar(literals[k]);
+        if (!seen[var] && levels[var] > 0) return false;
+    }
+    return true;
+}
+
+void SatSolver::backtrack(uint32_t level) {
+    if (decisionLevel() <= level) return;
+    for (size_t i = trail.size(); i-- > trailLimits[level];) {
+        uint32_t var = literalVar(trail[i]);
+        savedPhase[var] = assigns[var];
+        assigns[var] = UNASSIGNED;
+        reasons[var] = NO_REASON;
+        if (heapIndex[var] == NO_REASON) heapInsert(var);
+    }
+    trail.resize(trailLimits[level]);
+    trailLimits.resize(level);
+    propagateHead = trail.size();
+}
+
+Literal SatSolver::pickBranch() {
+    while (!heap.empty()) {
+        uint32_t var = heapPop();
+        if (assigns[var] == UNASSIGNED) return makeLiteral(var, savedPhase[var] == 0);
+    }
+    return NO_LITERAL;
+}
+
+void SatSolver::reduceLearnts() {
+    // Runs at level 0, where no reason clause is ever looked at again
+    std::vector<uint32_t> learnts;
+    for (uint32_t c = 0; c < clauses.size(); ++c) {
+        if (clauses[c].learnt) learnts.push_back(c);
+    }
+    std::stable_sort(learnts.begin(), learnts.end(), [&](uint32_t a, uint32_t b) { return clauses[a].lbd > clauses[b].lbd; });
+    for (size_t k = 0; k < learnts.size() / 2; ++k) {
+        // Glue clauses (two levels) are kept
+        if (clauses[learnts[k]].lbd > 2) clauses[learnts[k]].removed = true;
+    }
+
+    size_t kept = 0;
+    learntCount = 0;
+    for (size_t c = 0; c < clauses.size(); ++c) {
+        if (clauses[c].removed) continue;
+        learntCount += clauses[c].learnt;
+        if (kept != c) clauses[kept] = std::move(clauses[c]);
+        ++kept;
+    }
+    clauses.resize(kept);
+    for (Literal lit : trail) reasons[literalVar(lit)] = NO_REASON;
+
+    for (std::vector<Watcher> &list : watches) list.clear();
+    for (uint32_t c = 0; c < clauses.size(); ++c) attach(c);
+}
+
+void SatSolver::bumpActivity(uint32_t var) {
+    activity[var] += activityIncrement;
+    if (activity[var] > 1e100) {
+        for (double &a : activity) a *= 1e-100;
+        activityIncrement *= 1e-100;
+    }
+    if (heapIndex[var] != NO_REASON) heapUp(heapIndex[var]);
+}
+
+void SatSolver::heapInsert(uint32_t var) {
+    heapIndex[var] = static_cast<uint32_t>(heap.size());
+    heap.push_back(var);
+    heapUp(heap.size() - 1);
+}
+
+uint32_t SatSolver::heapPop() {
+    uint32_t top = heap[0];
+    heap[0] = heap.back();
+    heapIndex[heap[0]] = 0;
+    heap.pop_back();
+    heapIndex[top] = NO_REASON;
+    if (!heap.empty()) heapDown(0);
+    return top;
+}
+
+void SatSolver::heapUp(size_t position) {
+    uint32_t var = heap[position];
+    while (position > 0) {
+        size_t parent = (position - 1) / 2;
+        if (activity[heap[parent]] >= activity[var]) break;
+        heap[position] = heap[parent];
+        heapIndex[heap[position]] = static_cast<uint32_t>(position);
+        position = parent;
+    }
+    heap[position] = var;
+    heapIndex[var] = static_cast<uint32_t>(position);
+}
+
+void SatSolver::heapDown(size_t position) {
+    uint32_t var = heap[position];
+    for (;;) {
+        size_t child = 2 * position + 1;
+        if (child >= heap.size()) break;
+        if (child + 1 < heap.size() && activity[heap[child + 1]] > activity[heap[child]]) ++child;
+        if (activity[heap[child]] <= activity[var]) break;
+        heap[position] = heap[child];
+        heapIndex[heap[position]] = static_cast<uint32_t>(position);
+        position = child;
+    }
+    heap[position] = var;
+    heapIndex[var] = static_cast<uint32_t>(position);
+}
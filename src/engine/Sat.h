@@ -0,0 +1,97 @@
+// engine/Sat.h
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Literal of variable v: 2v is v, 2v + 1 is its negation
+using Literal = uint32_t;
+
+inline Literal makeLiteral(uint32_t var, bool negated = false) { return var * 2 + (negated ? 1 : 0); }
+inline Literal negateLiteral(Literal lit) { return lit ^ 1; }
+inline uint32_t literalVar(Literal lit) { return lit >> 1; }
+
+enum class SatResult { SATISFIABLE, UNSATISFIABLE, UNKNOWN };
+
+// Conflict-driven clause learning solver: two watched literals per clause, VSIDS branching
+// with phase saving, first-UIP learning with clause minimization, Luby restarts and
+// periodic removal of learned clauses with a high literal block distance.
+class SatSolver {
+   public:
+    uint32_t newVariable();
+    size_t variableCount() const { return assigns.size(); }
+
+    // Clauses may only be added before solve() or between calls; returns false once the
+    // formula is known to be unsatisfiable
+    bool addClause(std::vector<Literal> literals);
+
+    // UNKNOWN if the budget ran out first
+    SatResult solve(std::chrono::milliseconds budget = std::chrono::milliseconds(10000));
+
+    // Value of a variable in the model found by the last SATISFIABLE solve()
+    bool modelValue(uint32_t var) const { return model[var] != 0; }
+
+    size_t conflictCount() const { return conflicts; }
+
+   private:
+    static constexpr uint32_t NO_REASON = 0xFFFFFFFFu;
+    static constexpr uint8_t UNASSIGNED = 2;
+
+    struct Clause {
+        std::vector<Literal> literals;  // literals[0] and [1] are watched
+        bool learnt = false;
+        bool removed = false;
+        uint32_t lbd = 0;
+    };
+
+    struct Watcher {
+        uint32_t clause;
+        Literal blocker;  // if this is true the clause is satisfied and need not be visited
+    };
+
+    std::vector<Clause> clauses;
+    std::vector<std::vector<Watcher>> watches;  // watches[lit]: clauses watching negate(lit)
+    std::vector<uint8_t> assigns;               // per variable: 0, 1 or UNASSIGNED
+    std::vector<uint8_t> savedPhase;
+    std::vector<uint32_t> reasons;
+    std::vector<uint32_t> levels;
+    std::vector<Literal> trail;
+    std::vector<size_t> trailLimits;
+    size_t propagateHead = 0;
+    bool unsatisfiable = false;
+    std::vector<uint8_t> model;
+
+    // VSIDS: max-heap of variables by activity
+    std::vector<double> activity;
+    double activityIncrement = 1.0;
+    std::vector<uint32_t> heap;
+    std::vector<uint32_t> heapIndex;  // position in heap, NO_REASON if absent
+
+    std::vector<uint8_t> seen;
+    std::vector<uint32_t> learntLevels;
+    size_t conflicts = 0;
+    size_t learntCount = 0;
+
+    uint8_t value(Literal lit) const {
+        uint8_t v = assigns[literalVar(lit)];
+        return v == UNASSIGNED ? UNASSIGNED : v ^ (lit & 1);
+    }
+    uint32_t decisionLevel() const { return static_cast<uint32_t>(trailLimits.size()); }
+
+    void assign(Literal lit, uint32_t reason);
+    void attach(uint32_t clause);
+    uint32_t propagate();
+    void analyze(uint32_t conflict, std::vector<Literal> &learnt, uint32_t &backtrackLevel);
+    bool redundant(Literal lit) const;
+    void backtrack(uint32_t level);
+    Literal pickBranch();
+    void reduceLearnts();
+
+    void bumpActivity(uint32_t var);
+    void heapInsert(uint32_t var);
+    uint32_t heapPop();
+    void heapUp(size_t position);
+    void heapDown(size_t position);
+};
@@ -3,9 +3,52 @@
 #include "Simulator.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
+#include <unordered_map>
 
 #include "../ui/Configuration.h"
+#include "Aig.h"
+#include "BytecodeEvaluator.h"
+#include "ExpressionDag.h"
+#include "Minimizer.h"
+#include "NativeEvaluator.h"
+#include "Parallel.h"
+#include "TimedSimulation.h"
+#include "TruthTableExporter.h"
+
+namespace {
+
+// Counts below 2^53 are exact integers, larger ones print in scientific notation
+std::string formatCount(double count) {
+    if (count < 9007199254740992.0) return std::to_string(static_cast<uint64_t>(std::llround(count)));
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.6g", count);
+    return text;
+}
+
+// Back ends that cannot handle the netlist fall back to the interpreter, which keeps a
+// reference to it
+std::unique_ptr<CircuitEvaluator> makeEvaluator(const Netlist &netlist, EvaluatorBackend backend) {
+    if (backend == EvaluatorBackend::NATIVE) {
+        auto native = std::make_unique<NativeEvaluator>();
+        if (native->compile(netlist)) return native;
+        std::cout << "Native evaluator unavailable, using the interpreter: " << native->getError() << std::endl;
+    } else if (backend == EvaluatorBackend::BYTECODE) {
+        auto bytecode = std::make_unique<BytecodeEvaluator>();
+        if (bytecode->compile(netlist, false)) return bytecode;
+        std::cout << "Circuit too wide for the bytecode evaluator, using the interpreter" << std::endl;
+    } else if (backend == EvaluatorBackend::AIG) {
+        auto aig = std::make_unique<AigEvaluator>();
+        aig->compile(netlist);
+        std::cout << "AIG: " << netlist.gateCount() << " gates lowered to " << aig->getAig().andCount() << " AND nodes" << std::endl;
+        return aig;
+    }
+    return std::make_unique<InterpretedEvaluator>(netlist);
+}
+
+}  // namespace
 
 void Simulator::handleEvent(const sf::Event &event, const sf::RenderWindow &window, const sf::View &view, GateType selectedGateType) {
     if (const auto *clicked = event.getIf<sf::Event::MouseButtonPressed>()) {
@@ -65,12 +108,13 @@ void Simulator::handleEvent(const sf::Event &event, const sf::RenderWindow &wind
 
                 // Check input pins
                 if (gates[i].getType() != GateType::INPUT) {
-                    int inputCount = (gates[i].getType() == GateType::NOT) ? 1 : 2;
+                    int inputCount = Netlist::pinCount(gates[i].getType());
                     for (int j = 0; j < inputCount; ++j) {
                         sf::Vector2f inPin = gates[i].getInputPinPosition(j);
                         if (sf::FloatRect(inPin - sf::Vector2f{8.f, 8.f}, {16.f, 16.f}).contains(worldPos)) {
                             if (!selectingSource && selectedGate != std::numeric_limits<size_t>::max() && selectedGate < gates.size()) {
                                 wires.emplace_back(selectedGate, -1, i, j);
+                                structureDirty = true;
                                 selectedGate = std::numeric_limits<size_t>::max();
                                 selectedPin = -1;
                                 selectingSource = true;
@@ -83,8 +127,9 @@ void Simulator::handleEvent(const sf::Event &event, const sf::RenderWindow &wind
 
                 // Check gate body for selection or input toggle
                 if (gates[i].getBounds().contains(worldPos)) {
-                    if (gates[i].getType() == GateType::INPUT) {
-                        gates[i].setState(!gates[i].getState());  // Toggle input
+                    if (gates[i].getType() == GateType::INPUT || gates[i].getType() == GateType::CLOCK) {
+                        gates[i].setState(!gates[i].getState());  // Toggle input or clock by hand
+                        propagateInput(i);
                     }
                     selectGateAt(worldPos);
                     hitGate = true;
@@ -104,6 +149,7 @@ void Simulator::handleEvent(const sf::Event &event, const sf::RenderWindow &wind
                 } else {
                     gates.emplace_back(selectedGateType, worldPos);
                 }
+                structureDirty = true;
             }
         } else if (clicked->button == sf::Mouse::Button::Right) {
             // Cancel wire placement or deselect all gates
@@ -138,25 +184,31 @@ void Simulator::handleEvent(const sf::Event &event, const sf::RenderWindow &wind
     }
 }
 
-void Simulator::addInput(sf::Vector2f position) { gates.emplace_back(GateType::INPUT, position); }
+void Simulator::addInput(sf::Vector2f position) {
+    gates.emplace_back(GateType::INPUT, position);
+    structureDirty = true;
+}
 
 void Simulator::clearCircuit() {
     gates.clear();
     wires.clear();
+    structureDirty = true;
     selectedGate = std::numeric_limits<size_t>::max();
     selectedPin = -1;
     selectingSource = true;
     selectedGates.clear();
     currentExpression.clear();
-    truthTable.clear();
+    truthTable = TruthTable();
+    truthTableHeader.clear();
+    truthTableLines.clear();
     showTruthTable = false;
     showExpression = false;
     showInputField = false;
     inputExpression.clear();
     expression.clear();
     variables.clear();
-    varValues.clear();
-    minterms.clear();
+    expressionTable = TruthTable();
+    simplifiedExpression.clear();
     inputCounter = 0;
     outputCounter = 0;
     std::cout << "Circuit cleared!" << std::endl;
@@ -226,6 +278,7 @@ void Simulator::removeGate(size_t gateIndex) {
             wire = Wire(wire.getSrcGate(), wire.getSrcPin(), wire.getDstGate() - 1, wire.getDstPin());
         }
     }
+    structureDirty = true;
 }
 
 void Simulator::removeWiresConnectedToGate(size_t gateIndex) {
@@ -234,8 +287,123 @@ void Simulator::removeWiresConnectedToGate(size_t gateIndex) {
                 wires.end());
 }
 
+Simulator::~Simulator() {
+    if (exportJob) {
+        exportJob->exporter->cancel();
+        exportJob->thread.join();
+    }
+    // A running compiler cannot be interrupted; its directory is removed with the evaluator
+    if (nativeBuild) nativeBuild->thread.join();
+}
+
 void Simulator::update() {
-    // Update wire positions
+    // Each kind of work runs only when something it depends on changed, so an idle circuit costs nothing
+    pollExport();
+    pollNativeBuild();
+    compileNetlist();
+    if (stateDirty) evaluateCircuit();
+    if (geometryDirty) layoutWires();
+}
+
+void Simulator::compileNetlist() {
+    if (!structureDirty) return;
+
+    // Gates or wires were added/removed: new topology, stale values and stale wire endpoints
+    netlist.build(gates, wires);
+    if (netlist.hasCycles()) std::cout << "Circuit has " << netlist.loopCount() << " combinational loop(s)" << std::endl;
+    signals.resize(netlist.signalCount());
+    changedGates.reserve(netlist.gateCount());
+    circuitProgramReady = circuitProgram.compile(netlist, true);
+    signalWords.assign(netlist.signalCount(), 0);
+    circuitRegisters.assign(circuitProgram.registerCount(), 0);
+    evaluator.reset();
+    ++netlistVersion;
+    sequential.reset();
+    structureDirty = false;
+    stateDirty = true;
+    geometryDirty = true;
+}
+
+const CircuitEvaluator &Simulator::getEvaluator() {
+    compileNetlist();
+    if (evaluator) return *evaluator;
+
+    // The system compiler can take minutes on large netlists, so the native back end is built
+    // on a worker thread and the bytecode evaluator stands in until update() swaps it in
+    if (evaluatorBackend == EvaluatorBackend::NATIVE) {
+        if (!nativeBuild) startNativeBuild();
+        evaluator = makeEvaluator(netlist, EvaluatorBackend::BYTECODE);
+        return *evaluator;
+    }
+    evaluator = makeEvaluator(netlist, evaluatorBackend);
+    return *evaluator;
+}
+
+void Simulator::startNativeBuild() {
+    nativeBuild = std::make_unique<NativeBuild>();
+    NativeBuild &build = *nativeBuild;
+    build.netlist = netlist;
+    build.version = netlistVersion;
+    build.native = std::make_unique<NativeEvaluator>();
+    build.thread = std::thread([&build] {
+        build.ok = build.native->compile(build.netlist);
+        build.finished = true;
+    });
+    std::cout << "Compiling the native evaluator, using bytecode until it loads" << std::endl;
+}
+
+void Simulator::pollNativeBuild() {
+    if (!nativeBuild || !nativeBuild->finished) return;
+    nativeBuild->thread.join();
+    std::unique_ptr<NativeBuild> build = std::move(nativeBuild);
+    if (evaluatorBackend != EvaluatorBackend::NATIVE) return;
+
+    if (build->version != netlistVersion) {
+        // The circuit changed while compiling; the stand-in serves the new one meanwhile
+        startNativeBuild();
+    } else if (!build->ok) {
+        std::cout << "Native evaluator unavailable, staying on bytecode: " << build->native->getError() << std::endl;
+    } else {
+        evaluator = std::move(build->native);
+        std::cout << "Native evaluator loaded" << std::endl;
+    }
+}
+
+void Simulator::cycleEvaluatorBackend() {
+    switch (evaluatorBackend) {
+        case EvaluatorBackend::INTERPRETER:
+            evaluatorBackend = EvaluatorBackend::BYTECODE;
+            break;
+        case EvaluatorBackend::BYTECODE:
+            evaluatorBackend = EvaluatorBackend::NATIVE;
+            break;
+        case EvaluatorBackend::NATIVE:
+            evaluatorBackend = EvaluatorBackend::AIG;
+            break;
+        case EvaluatorBackend::AIG:
+            evaluatorBackend = EvaluatorBackend::INTERPRETER;
+            break;
+    }
+    evaluator.reset();
+    std::cout << "Evaluator backend: " << getEvaluator().getName() << std::endl;
+}
+
+void Simulator::cycleMinimizeMode() {
+    switch (minimizeMode) {
+        case MinimizeMode::AUTO:
+            minimizeMode = MinimizeMode::EXACT;
+            break;
+        case MinimizeMode::EXACT:
+            minimizeMode = MinimizeMode::HEURISTIC;
+            break;
+        case MinimizeMode::HEURISTIC:
+            minimizeMode = MinimizeMode::AUTO;
+            break;
+    }
+    std::cout << "Minimizer: " << getMinimizeModeName(minimizeMode) << std::endl;
+}
+
+void Simulator::layoutWires() {
     for (auto &wire : wires) {
         if (wire.getSrcGate() < gates.size() && wire.getDstGate() < gates.size()) {
             sf::Vector2f start = gates[wire.getSrcGate()].getOutputPinPosition();
@@ -243,61 +411,118 @@ void Simulator::update() {
             wire.setPositions(start, end);
         }
     }
-    evaluateCircuit();
+    geometryDirty = false;
 }
 
-void Simulator::evaluateCircuit() {
-    // Reset all gate states except inputs
-    for (auto &gate : gates) {
-        if (gate.getType() != GateType::INPUT) {
-            gate.setState(false);
-        }
+void Simulator::propagateInput(size_t gateIndex) {
+    if (structureDirty || stateDirty || netlist.isSequential()) {
+        evaluateCircuit();
+        return;
     }
 
-    // Topological evaluation
-    std::vector<bool> evaluated(gates.size(), false);
-    bool progress = true;
+    // Only the fan-out cone of the toggled input is re-evaluated
+    signals[gateIndex] = gates[gateIndex].getState();
+    changedGates.clear();
+    netlist.propagate(signals, static_cast<uint32_t>(gateIndex), changedGates);
+    if (netlist.hasCycles()) setCycleState(netlist.solveCycles(signals, &changedGates));
+    for (uint32_t g : changedGates) {
+        gates[g].setState(signals[g]);
+    }
+}
 
-    while (progress) {
-        progress = false;
-        for (size_t i = 0; i < gates.size(); ++i) {
-            if (evaluated[i] || gates[i].getType() == GateType::INPUT) {
-                if (gates[i].getType() == GateType::INPUT) evaluated[i] = true;
-                continue;
-            }
+void Simulator::evaluateCircuit() {
+    compileNetlist();
+
+    if (netlist.isSequential()) {
+        if (!sequential) {
+            // Registers keep their state in the gates across rebuilds
+            for (uint32_t g : netlist.getInputs()) signals[g] = gates[g].getState();
+            for (uint32_t g : netlist.getClocks()) signals[g] = gates[g].getState();
+            for (uint32_t g : netlist.getRegisters()) signals[g] = gates[g].getState();
+            sequential = std::make_unique<CycleSimulation>(netlist);
+            setCycleState(sequential->reset(signals));
+        } else {
+            for (uint32_t g : netlist.getInputs()) sequential->setSource(g, gates[g].getState());
+            for (uint32_t g : netlist.getClocks()) sequential->setSource(g, gates[g].getState());
+            setCycleState(sequential->settle());
+        }
+        signals = sequential->getValues();
+    } else if (circuitProgramReady) {
+        for (uint32_t g : netlist.getInputs()) {
+            signalWords[g] = gates[g].getState() ? ~uint64_t(0) : 0;
+        }
 
-            // Check if all inputs are available
-            std::vector<bool> inputs;
-            int inputCount = (gates[i].getType() == GateType::NOT) ? 1 : 2;
-            bool allInputsReady = true;
+        // One run of the bytecode program, one word per signal
+        circuitProgram.run(signalWords.data(), circuitRegisters.data(), 1);
 
-            for (int j = 0; j < inputCount; ++j) {
-                bool inputValue = false;
-                bool inputFound = false;
+        // The program zeroes gates on a cycle; they keep their last values as the starting state
+        signals[netlist.constZero()] = 0;
+        for (uint32_t g : netlist.getOrder()) {
+            signals[g] = static_cast<uint8_t>(signalWords[g] & 1);
+        }
+        if (netlist.hasCycles()) setCycleState(netlist.solveCycles(signals));
+    } else {
+        for (uint32_t g : netlist.getInputs()) {
+            signals[g] = gates[g].getState();
+        }
+        setCycleState(netlist.evaluate(signals));
+    }
+    for (size_t i = 0; i < gates.size(); ++i) {
+        if (gates[i].getType() != GateType::INPUT) {
+            gates[i].setState(signals[i]);
+        }
+    }
+    stateDirty = false;
+}
 
-                for (const auto &wire : wires) {
-                    if (wire.getDstGate() == i && wire.getDstPin() == j && wire.getSrcGate() < gates.size()) {
-                        if (evaluated[wire.getSrcGate()]) {
-                            inputValue = gates[wire.getSrcGate()].getState();
-                            inputFound = true;
-                            break;
-                        } else {
-                            allInputsReady = false;
-                            break;
-                        }
-                    }
-                }
+void Simulator::stepClock(bool benchmark) {
+    compileNetlist();
+    if (stateDirty || !sequential) evaluateCircuit();
+    if (netlist.getClocks().empty()) {
+        std::cout << "No CLOCK gates to step" << std::endl;
+        return;
+    }
 
-                if (!allInputsReady) break;
-                inputs.push_back(inputValue);
-            }
+    if (benchmark) {
+        // Headless run on a copy, so the circuit on the canvas keeps its state
+        CycleSimulation run(netlist);
+        run.reset(sequential->getValues());
+        auto start = std::chrono::steady_clock::now();
+        CycleState state = run.run(BENCHMARK_CYCLES);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<std::string> lines;
+        lines.push_back(formatCount(static_cast<double>(BENCHMARK_CYCLES)) + " clock cycles of " + std::to_string(netlist.gateCount()) +
+                        " gates in " + std::to_string(static_cast<int>(ms)) + " ms");
+        lines.push_back(formatCount(BENCHMARK_CYCLES / std::max(ms, 1e-3) * 1000.0) + " cycles per second");
+        if (state != CycleState::STABLE) lines.push_back("Some edges did not settle");
+        setTruthTableMessage(lines);
+        showTruthTable = true;
+        for (const std::string &line : lines) std::cout << line << std::endl;
+        return;
+    }
 
-            if (allInputsReady) {
-                gates[i].setState(gates[i].evaluate(inputs));
-                evaluated[i] = true;
-                progress = true;
-            }
-        }
+    setCycleState(sequential->run(1));
+    signals = sequential->getValues();
+    for (size_t i = 0; i < gates.size(); ++i) {
+        if (gates[i].getType() != GateType::INPUT) gates[i].setState(signals[i]);
+    }
+    std::cout << "Clock cycle " << sequential->edgeCount() / 2 << std::endl;
+}
+
+void Simulator::setCycleState(CycleState state) {
+    if (state == cycleState) return;
+    cycleState = state;
+    switch (state) {
+        case CycleState::STABLE:
+            std::cout << "Combinational loops settled" << std::endl;
+            break;
+        case CycleState::OSCILLATING:
+            std::cout << "Combinational loop oscillates, showing one of its states" << std::endl;
+            break;
+        case CycleState::UNRESOLVED:
+            std::cout << "Combinational loop did not settle within " << Netlist::MAX_LOOP_SWEEPS << " sweeps" << std::endl;
+            break;
     }
 }
 
@@ -370,8 +595,8 @@ void Simulator::drawUI(sf::RenderWindow &window) const {
     }
 
     // Draw truth table
-    if (showTruthTable && !truthTable.empty() && currentFont && truthTableTitleText) {
-        float tableHeight = std::min(400.f, (float)truthTable.size() * 20.f + 80.f);
+    if (showTruthTable && !truthTableLines.empty() && currentFont && truthTableTitleText) {
+        float tableHeight = std::min(400.f, (float)getTruthTableLineCount() * 20.f + 80.f);
         sf::RectangleShape tableBg({380.f, tableHeight});
         tableBg.setPosition({rightSide, 200.f});
         tableBg.setFillColor(sf::Color(0, 0, 0, 180));
@@ -400,15 +625,15 @@ void Simulator::drawUI(sf::RenderWindow &window) const {
 
         // Draw table headers and data
         float yPos = 230.f;
-        for (size_t i = 0; i < std::min((size_t)15, truthTableTexts.size()); ++i) {
+        for (size_t i = 0; i < std::min(TRUTH_TABLE_VISIBLE_LINES, truthTableTexts.size()); ++i) {
             truthTableTexts[i].setPosition({rightSide + 10.f, yPos});
             window.draw(truthTableTexts[i]);
             yPos += 18.f;
         }
 
-        if (truthTable.size() > 15) {
+        if (getTruthTableLineCount() > TRUTH_TABLE_VISIBLE_LINES) {
             sf::Text moreText(*currentFont);
-            moreText.setString("... (showing first 15 rows)");
+            moreText.setString("... (showing first " + std::to_string(TRUTH_TABLE_VISIBLE_LINES) + " rows)");
             moreText.setCharacterSize(10);
             moreText.setFillColor(sf::Color(128, 128, 128));
             moreText.setPosition({rightSide + 10.f, yPos});
@@ -492,218 +717,432 @@ void Simulator::generateLogicalExpression() {
         return;
     }
 
-    auto outputs = getOutputGates();
-    if (outputs.empty()) {
+    compileNetlist();
+    if (netlist.getOutputs().empty()) {
         currentExpression = "No OUTPUT gates found";
         showExpression = true;
         std::cout << currentExpression << std::endl;
         return;
     }
 
-    std::map<size_t, std::string> expressions;
-    auto inputs = getInputGates();
-
-    for (size_t i = 0; i < inputs.size(); ++i) {
-        char varName = 'A' + i;
-        expressions[inputs[i]] = std::string(1, varName);
-    }
-
-    currentExpression = generateExpressionForGate(outputs[0], expressions);
+    // Every output in one pass; cones shared between outputs are bound once
+    currentExpression = extractCircuitExpressions(netlist).render();
     showExpression = true;
     setupUITexts();
 
     std::cout << "Generated expression: " << currentExpression << std::endl;
 }
 
-std::string Simulator::generateExpressionForGate(size_t gateIndex, std::map<size_t, std::string> &expressions) const {
-    if (expressions.find(gateIndex) != expressions.end()) {
-        return expressions[gateIndex];
+void Simulator::generateTruthTable() {
+    if (showTruthTable) {
+        showTruthTable = false;
+        return;
     }
 
-    if (gateIndex >= gates.size()) {
-        return "?";
+    auto inputs = getInputGates();
+    auto outputs = getOutputGates();
+
+    if (inputs.empty() || outputs.empty()) {
+        setTruthTableMessage("No inputs or outputs found");
+        showTruthTable = true;
+        std::cout << "Cannot generate truth table: No inputs or outputs found" << std::endl;
+        return;
     }
 
-    const Gate &gate = gates[gateIndex];
-    std::string result;
+    if (inputs.size() > MAX_TABLE_INPUTS) {
+        setTruthTableMessage("Too many inputs (" + std::to_string(inputs.size()) + "), press X to export");
+        showTruthTable = true;
+        std::cout << "Truth table with " << inputs.size() << " inputs is too large to display, export it instead" << std::endl;
+        return;
+    }
 
-    switch (gate.getType()) {
-        case GateType::INPUT:
-            result = "INPUT";
-            break;
+    truthTableHeader.clear();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        truthTableHeader += "In" + std::to_string(i) + "  ";
+    }
+    truthTableHeader += " | ";
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        truthTableHeader += "Out" + std::to_string(i) + " ";
+    }
 
-        case GateType::NOT: {
-            for (const auto &wire : wires) {
-                if (wire.getDstGate() == gateIndex && wire.getDstPin() == 0) {
-                    std::string input = generateExpressionForGate(wire.getSrcGate(), expressions);
-                    result = "¬(" + input + ")";
-                    break;
-                }
-            }
-            if (result.empty()) result = "¬(?)";
-            break;
-        }
+    const CircuitEvaluator &backend = getEvaluator();
 
-        case GateType::AND: {
-            std::vector<std::string> inputs;
-            for (int pin = 0; pin < 2; ++pin) {
-                for (const auto &wire : wires) {
-                    if (wire.getDstGate() == gateIndex && wire.getDstPin() == pin) {
-                        inputs.push_back(generateExpressionForGate(wire.getSrcGate(), expressions));
-                        break;
-                    }
-                }
-            }
-            if (inputs.size() >= 2)
-                result = "(" + inputs[0] + " ∧ " + inputs[1] + ")";
-            else
-                result = "(? ∧ ?)";
-            break;
-        }
+    size_t numInputs = inputs.size();
+    truthTable = TruthTable(numInputs, outputs.size(), InputOrder::LSB_FIRST);
+    uint64_t combinations = truthTable.getRowCount();
 
-        case GateType::OR: {
-            std::vector<std::string> inputs;
-            for (int pin = 0; pin < 2; ++pin) {
-                for (const auto &wire : wires) {
-                    if (wire.getDstGate() == gateIndex && wire.getDstPin() == pin) {
-                        inputs.push_back(generateExpressionForGate(wire.getSrcGate(), expressions));
-                        break;
-                    }
+    // Up to 512 combinations per pass: each signal is a block of words, one combination per bit
+    const size_t blockWords = static_cast<size_t>(std::min<uint64_t>(PATTERN_BLOCK_WORDS, truthTable.wordCount()));
+    const uint64_t blockRows = 64 * blockWords;
+    const size_t blockCount = static_cast<size_t>((combinations + blockRows - 1) / blockRows);
+
+    // Blocks are sharded across workers, each with its own signal buffer; every block owns its column words
+    std::vector<std::vector<uint64_t>> workerBlocks(parallelWorkerCount());
+    parallelFor(blockCount, TRUTH_TABLE_CHUNK_BLOCKS, [&](size_t begin, size_t end, size_t worker) {
+        std::vector<uint64_t> &blocks = workerBlocks[worker];
+        blocks.resize(netlist.signalCount() * blockWords);
+
+        for (size_t block = begin; block < end; ++block) {
+            uint64_t base = block * blockRows;
+            for (size_t i = 0; i < numInputs; ++i) {
+                for (size_t w = 0; w < blockWords; ++w) {
+                    blocks[inputs[i] * blockWords + w] = Netlist::inputPattern(i, base + 64 * w);
                 }
             }
-            if (inputs.size() >= 2)
-                result = "(" + inputs[0] + " ∨ " + inputs[1] + ")";
-            else
-                result = "(? ∨ ?)";
-            break;
-        }
 
-        case GateType::OUTPUT: {
-            for (const auto &wire : wires) {
-                if (wire.getDstGate() == gateIndex && wire.getDstPin() == 0) {
-                    result = generateExpressionForGate(wire.getSrcGate(), expressions);
-                    break;
+            backend.evaluate(blocks, blockWords);
+
+            uint64_t rows = std::min<uint64_t>(blockRows, combinations - base);
+            uint64_t tail = rows % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (rows % 64)) - 1;
+            size_t words = static_cast<size_t>((rows + 63) / 64);
+            for (size_t o = 0; o < outputs.size(); ++o) {
+                uint64_t *column = truthTable.column(o) + base / 64;
+                for (size_t w = 0; w < words; ++w) {
+                    column[w] = blocks[outputs[o] * blockWords + w];
                 }
+                column[words - 1] &= tail;
             }
-            if (result.empty()) result = "?";
-            break;
         }
-    }
+    });
+
+    showTruthTable = true;
+    formatTruthTable();
+    setupUITexts();
 
-    expressions[gateIndex] = result;
-    return result;
+    std::cout << "Generated truth table with " << combinations << " rows" << std::endl;
 }
 
-void Simulator::generateTruthTable() {
-    if (showTruthTable) {
-        showTruthTable = false;
+void Simulator::exportTruthTable(ExportFormat format) {
+    if (exportJob) {
+        exportJob->exporter->cancel();
+        std::cout << "Cancelling truth table export" << std::endl;
         return;
     }
+    compileNetlist();
+
+    // The worker exports a copy of the netlist with its own evaluator, so the circuit can be
+    // edited while it runs; update() reports progress and the result
+    exportJob = std::make_unique<ExportJob>();
+    ExportJob &job = *exportJob;
+    job.netlist = netlist;
+    job.exporter = std::make_unique<TruthTableExporter>(job.netlist);
+    job.path = format == ExportFormat::CSV ? "truth_table.csv" : format == ExportFormat::PLA ? "truth_table.pla" : "truth_table.bin";
+    job.thread = std::thread([&job, format, backend = evaluatorBackend] {
+        // Built here, as the native back end runs the system compiler
+        job.evaluator = makeEvaluator(job.netlist, backend);
+        job.exporter->setEvaluator(job.evaluator.get());
+        job.ok = job.exporter->exportTo(job.path, format);
+        job.finished = true;
+    });
+    exportPercent = -1;
+    pollExport();
+}
 
-    auto inputs = getInputGates();
-    auto outputs = getOutputGates();
-
-    if (inputs.empty() || outputs.empty()) {
-        truthTable = {"No inputs or outputs found"};
-        showTruthTable = true;
-        std::cout << "Cannot generate truth table: No inputs or outputs found" << std::endl;
+void Simulator::pollExport() {
+    if (!exportJob) return;
+    ExportJob &job = *exportJob;
+
+    if (!job.finished) {
+        const uint64_t rowsWritten = job.exporter->getRowsWritten();
+        const uint64_t rowCount = job.exporter->getRowCount();
+        int percent = static_cast<int>(100.0 * static_cast<double>(rowsWritten) / static_cast<double>(rowCount));
+        if (percent != exportPercent) {
+            exportPercent = percent;
+            setTruthTableMessage({"Exporting " + job.path + ": " + std::to_string(percent) + "% (" + formatCount(static_cast<double>(rowsWritten)) +
+                                      " of " + formatCount(static_cast<double>(rowCount)) + " rows)",
+                                  "Press X again to cancel"});
+            showTruthTable = true;
+        }
         return;
     }
 
-    truthTable.clear();
+    job.thread.join();
+    std::string line = job.ok ? "Exported truth table to " + job.path : "Cannot export truth table: " + job.exporter->getError();
+    setTruthTableMessage(line);
+    showTruthTable = true;
+    std::cout << line << std::endl;
+    exportJob.reset();
+}
 
-    std::string header;
-    for (size_t i = 0; i < inputs.size(); ++i) {
-        header += "In" + std::to_string(i) + "  ";
+void Simulator::analyzeWithBdd() {
+    compileNetlist();
+    std::vector<std::string> lines;
+    BddManager manager;
+
+    // Circuit inputs are variables 0..n-1 in depth-first order from the outputs
+    const size_t inputCount = netlist.getInputs().size();
+    std::vector<uint32_t> variableOf = netlistVariableOrder(netlist);
+    std::vector<BddManager::Edge> outputs;
+    if (!netlist.getOutputs().empty()) {
+        if (buildNetlistBdds(manager, netlist, variableOf, outputs)) {
+            for (size_t o = 0; o < outputs.size(); ++o) {
+                lines.push_back("Out" + std::to_string(o) + ": " + std::to_string(manager.nodeCount(outputs[o])) + " nodes, " +
+                                formatCount(manager.satCount(outputs[o], static_cast<uint32_t>(inputCount))) + " of 2^" +
+                                std::to_string(inputCount) + " rows true");
+            }
+        } else {
+            lines.push_back("Circuit: " + manager.getError());
+        }
     }
-    header += " | ";
-    for (size_t i = 0; i < outputs.size(); ++i) {
-        header += "Out" + std::to_string(i) + " ";
+
+    // Expression letters A, B, ... name circuit inputs 0, 1, ... as in generateLogicalExpression();
+    // other letters get variables of their own
+    if (!expression.empty() && compiledExpression.compile(expression)) {
+        const std::vector<char> &letters = compiledExpression.getVariables();
+        std::vector<uint32_t> letterVariable(letters.size());
+        uint32_t nextVariable = static_cast<uint32_t>(inputCount);
+        bool sharesInputs = true;
+        for (size_t j = 0; j < letters.size(); ++j) {
+            size_t input = static_cast<size_t>(letters[j] - 'A');
+            bool mapped = letters[j] >= 'A' && letters[j] <= 'Z' && input < inputCount;
+            letterVariable[j] = mapped ? variableOf[input] : nextVariable++;
+            sharesInputs = sharesInputs && mapped;
+        }
+
+        BddManager::Edge f = buildExpressionBdd(manager, compiledExpression, letterVariable);
+        if (f == BddManager::INVALID) {
+            lines.push_back("Expression: " + manager.getError());
+        } else {
+            double rows = manager.satCount(f, nextVariable) / std::ldexp(1.0, static_cast<int>(nextVariable - letters.size()));
+            lines.push_back("Expression: " + std::to_string(manager.nodeCount(f)) + " nodes, " + formatCount(rows) + " of 2^" +
+                            std::to_string(letters.size()) + " rows true");
+
+            if (!outputs.empty() && sharesInputs) {
+                // Canonical form: equal functions have equal edges
+                BddManager::Edge difference = manager.bddXor(outputs[0], f);
+                std::vector<int8_t> assignment(nextVariable, -1);
+                if (difference == BddManager::INVALID) {
+                    lines.push_back("Out0 vs expression: " + manager.getError());
+                } else if (!manager.satisfyingAssignment(difference, assignment)) {
+                    lines.push_back("Out0 is equivalent to the expression");
+                } else {
+                    std::string where;
+                    for (size_t i = 0; i < inputCount && i < 26; ++i) {
+                        where += std::string(1, static_cast<char>('A' + i)) + "=" + (assignment[variableOf[i]] == 1 ? "1 " : "0 ");
+                    }
+                    lines.push_back("Out0 differs from the expression at " + where);
+                }
+            }
+        }
     }
-    truthTable.push_back(header);
 
-    std::string separator(header.length(), '-');
-    truthTable.push_back(separator);
+    if (lines.empty()) lines.push_back("No outputs or expression to analyze");
+    setTruthTableMessage(lines);
+    showTruthTable = true;
+    for (const std::string &line : lines) std::cout << line << std::endl;
+}
+
+void Simulator::analyzeHazards() {
+    compileNetlist();
+    if (stateDirty) evaluateCircuit();
+    std::vector<std::string> lines;
+    const std::vector<uint32_t> &inputs = netlist.getInputs();
+    const std::vector<uint32_t> &outputs = netlist.getOutputs();
 
-    int numInputs = inputs.size();
-    int combinations = 1 << numInputs;
+    if (inputs.empty() || outputs.empty()) {
+        lines.push_back("Hazard analysis needs INPUT and OUTPUT gates");
+    } else {
+        // Toggle each input in turn from the state on the canvas; an output that switches
+        // more than once before settling has a hazard for that transition
+        std::vector<uint32_t> outputIndex(netlist.gateCount(), 0);
+        for (size_t o = 0; o < outputs.size(); ++o) outputIndex[outputs[o]] = static_cast<uint32_t>(o);
+        std::vector<std::vector<TimedSimulation::Transition>> byOutput(outputs.size());
+
+        TimedSimulation timed(netlist);
+        size_t events = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            const std::string edge = "In" + std::to_string(i) + (signals[inputs[i]] ? " falling: " : " rising: ");
+            timed.reset(signals);
+            timed.setInput(inputs[i], !signals[inputs[i]], 0);
+            events += timed.run(MAX_TIMED_TICKS);
+            if (!timed.idle()) {
+                lines.push_back(edge + "still switching after " + std::to_string(MAX_TIMED_TICKS) + " ticks");
+                continue;
+            }
 
-    for (int combo = 0; combo < combinations; ++combo) {
-        for (int i = 0; i < numInputs; ++i) {
-            bool value = (combo >> i) & 1;
-            gates[inputs[i]].setState(value);
+            for (auto &list : byOutput) list.clear();
+            for (const TimedSimulation::Transition &t : timed.getTransitions()) byOutput[outputIndex[t.gate]].push_back(t);
+            for (size_t o = 0; o < outputs.size(); ++o) {
+                const auto &list = byOutput[o];
+                if (list.size() < 2) continue;
+                std::string waveform = signals[outputs[o]] ? "1" : "0";
+                for (size_t k = 0; k < list.size() && k < 8; ++k) waveform += std::string("->") + (list[k].value ? "1" : "0");
+                if (list.size() > 8) waveform += "...";
+                const bool isStatic = list.back().value == signals[outputs[o]];
+                lines.push_back(edge + "Out" + std::to_string(o) + (isStatic ? " static" : " dynamic") + " hazard " + waveform + " at t=" +
+                                std::to_string(list.front().time) + ".." + std::to_string(list.back().time));
+            }
         }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (lines.empty()) lines.push_back("No glitches when a single input toggles from the current inputs");
+        lines.push_back(formatCount(static_cast<double>(events)) + " events in " + std::to_string(static_cast<int>(ms)) + " ms");
+    }
 
-        const_cast<Simulator *>(this)->evaluateCircuit();
+    setTruthTableMessage(lines);
+    showTruthTable = true;
+    for (const std::string &line : lines) std::cout << line << std::endl;
+}
 
-        std::string row;
-        for (int i = 0; i < numInputs; ++i) {
-            row += (gates[inputs[i]].getState() ? " 1" : " 0");
-            row += "   ";
+void Simulator::verifyAgainstExpression() {
+    compileNetlist();
+    std::vector<std::string> lines;
+    const size_t inputCount = netlist.getInputs().size();
+
+    if (netlist.getOutputs().empty()) {
+        lines.push_back("No OUTPUT gates to verify");
+    } else if (expression.empty()) {
+        lines.push_back("No expression entered");
+    } else if (!compiledExpression.compile(expression)) {
+        lines.push_back("Invalid expression: " + compiledExpression.getError());
+    } else {
+        // Letters A, B, ... are inputs 0, 1, ... as in generateLogicalExpression(); any
+        // other letter is a free variable of its own
+        const std::vector<char> &letters = compiledExpression.getVariables();
+        std::vector<uint32_t> inputOf(letters.size());
+        std::vector<std::string> names;
+        for (size_t i = 0; i < inputCount; ++i) names.push_back(i < 26 ? std::string(1, static_cast<char>('A' + i)) : "In" + std::to_string(i));
+        for (size_t j = 0; j < letters.size(); ++j) {
+            size_t input = static_cast<size_t>(letters[j] - 'A');
+            if (letters[j] >= 'A' && letters[j] <= 'Z' && input < inputCount) {
+                inputOf[j] = static_cast<uint32_t>(input);
+            } else {
+                inputOf[j] = static_cast<uint32_t>(names.size());
+                names.push_back(std::string(1, letters[j]));
+            }
         }
-        row += " | ";
-        for (size_t i = 0; i < outputs.size(); ++i) {
-            row += (gates[outputs[i]].getState() ? "  1" : "  0");
-            row += "   ";
+
+        EquivalenceCheck check =
+            checkEquivalence(netlist, 0, compiledExpression, inputOf, std::chrono::milliseconds(EQUIVALENCE_TIME_BUDGET_MS));
+        if (check.result == Equivalence::EQUIVALENT) {
+            lines.push_back("Out0 implements the expression");
+        } else if (check.result == Equivalence::UNKNOWN) {
+            lines.push_back("Gave up after " + std::to_string(check.conflicts) + " conflicts");
+        } else {
+            lines.push_back("Out0 differs from the expression at:");
+            std::string where;
+            for (size_t i = 0; i < names.size(); ++i) where += names[i] + "=" + (check.counterexample[i] ? "1 " : "0 ");
+            lines.push_back(where);
         }
-        truthTable.push_back(row);
     }
 
+    setTruthTableMessage(lines);
     showTruthTable = true;
-    setupUITexts();
+    for (const std::string &line : lines) std::cout << line << std::endl;
+}
 
-    std::cout << "Generated truth table with " << combinations << " rows" << std::endl;
+void Simulator::saveReferenceCircuit() {
+    compileNetlist();
+    referenceCircuit = netlist;
+    referenceSaved = true;
+    std::cout << "Saved reference circuit with " << netlist.getInputs().size() << " inputs and " << netlist.getOutputs().size() << " outputs"
+              << std::endl;
+}
+
+void Simulator::verifyAgainstReference() {
+    compileNetlist();
+    std::vector<std::string> lines;
+
+    if (!referenceSaved) {
+        lines.push_back("No reference circuit saved (Shift+V)");
+    } else if (netlist.getInputs().size() != referenceCircuit.getInputs().size() ||
+               netlist.getOutputs().size() != referenceCircuit.getOutputs().size()) {
+        lines.push_back("Reference has " + std::to_string(referenceCircuit.getInputs().size()) + " inputs and " +
+                        std::to_string(referenceCircuit.getOutputs().size()) + " outputs");
+    } else {
+        // Inputs and outputs are paired in gate order, as in the truth table columns
+        EquivalenceCheck check = checkEquivalence(referenceCircuit, netlist, std::chrono::milliseconds(EQUIVALENCE_TIME_BUDGET_MS));
+        if (check.result == Equivalence::EQUIVALENT) {
+            lines.push_back("Circuit is equivalent to the reference");
+        } else if (check.result == Equivalence::UNKNOWN) {
+            lines.push_back("Gave up after " + std::to_string(check.conflicts) + " conflicts");
+        } else {
+            lines.push_back("Out" + std::to_string(check.output) + " differs from the reference at:");
+            std::string where;
+            for (size_t i = 0; i < check.counterexample.size(); ++i) {
+                where += "In" + std::to_string(i) + "=" + (check.counterexample[i] ? "1 " : "0 ");
+            }
+            lines.push_back(where);
+        }
+    }
+
+    setTruthTableMessage(lines);
+    showTruthTable = true;
+    for (const std::string &line : lines) std::cout << line << std::endl;
 }
 
 void Simulator::generateExpressionTruthTable() {
     if (expression.empty()) {
-        truthTable = {"No expression entered"};
+        setTruthTableMessage("No expression entered");
         showTruthTable = true;
         std::cout << "No expression entered!" << std::endl;
         return;
     }
 
-    variables.clear();
-    for (char c : expression) {
-        if (std::isalpha(c)) {
-            variables.push_back(c);
-        }
+    if (!compiledExpression.compile(expression)) {
+        simplifiedExpression.clear();
+        setTruthTableMessage("Invalid expression: " + compiledExpression.getError());
+        showTruthTable = true;
+        std::cout << "Invalid expression: " << compiledExpression.getError() << std::endl;
+        return;
     }
-    removeDuplicateVariables();
-
-    std::string postfix = infixToPostfix(expression);
-    int varCount = variables.size();
-    int rows = 1 << varCount;
-    minterms.clear();
-    truthTable.clear();
+    variables = compiledExpression.getVariables();
 
-    std::string header;
-    for (char var : variables) {
-        header += std::string(1, var) + "  ";
+    if (variables.size() > MAX_TABLE_INPUTS) {
+        // No table, but the BDD still gives an irredundant cover
+        expressionTable = TruthTable();
+        setTruthTableMessage("Too many variables (" + std::to_string(variables.size()) + ") for a table");
+        showTruthTable = true;
+        currentExpression = simplifyWideExpression();
+        showExpression = true;
+        setupUITexts();
+        std::cout << "Expression has too many variables for a truth table" << std::endl;
+        std::cout << "Simplified expression: " << currentExpression << std::endl;
+        return;
     }
-    header += "| " + expression;
-    truthTable.push_back(header);
 
-    std::string separator(header.length(), '-');
-    truthTable.push_back(separator);
+    const size_t varCount = variables.size();
+    expressionTable = TruthTable(varCount, 1, InputOrder::MSB_FIRST);
+    uint64_t rows = expressionTable.getRowCount();
 
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < varCount; j++) {
-            varValues[variables[j]] = (i >> (varCount - 1 - j)) & 1;
+    truthTableHeader.clear();
+    for (char var : variables) {
+        truthTableHeader += std::string(1, var) + "  ";
+    }
+    truthTableHeader += "| " + expression;
+
+    // 64 rows per word and up to PATTERN_BLOCK_WORDS words per pass. Variable j is bit
+    // varCount - 1 - j of the row, so its column words are the circuit input patterns.
+    const size_t blockWords = static_cast<size_t>(std::min<uint64_t>(PATTERN_BLOCK_WORDS, expressionTable.wordCount()));
+    const size_t blockCount = (expressionTable.wordCount() + blockWords - 1) / blockWords;
+    uint64_t *result = expressionTable.column(0);
+
+    std::vector<std::vector<uint64_t>> workerColumns(parallelWorkerCount(), std::vector<uint64_t>(varCount * blockWords));
+    std::vector<std::vector<uint64_t>> workerStacks(parallelWorkerCount(), std::vector<uint64_t>(compiledExpression.stackSize() * blockWords));
+    parallelFor(blockCount, TRUTH_TABLE_CHUNK_BLOCKS, [&](size_t begin, size_t end, size_t worker) {
+        uint64_t *columns = workerColumns[worker].data();
+        uint64_t *stack = workerStacks[worker].data();
+
+        for (size_t block = begin; block < end; ++block) {
+            size_t firstWord = block * blockWords;
+            size_t words = std::min(blockWords, expressionTable.wordCount() - firstWord);
+            for (size_t j = 0; j < varCount; ++j) {
+                for (size_t w = 0; w < words; ++w) {
+                    columns[j * words + w] = Netlist::inputPattern(varCount - 1 - j, 64 * (firstWord + w));
+                }
+            }
+            compiledExpression.evaluateWords(columns, stack, result + firstWord, words);
         }
+    });
 
-        bool result = evaluatePostfix(postfix);
-        minterms.push_back(result);
+    // Tables under 64 rows use only the low bits of their single word
+    if (rows < 64) result[0] &= (uint64_t(1) << rows) - 1;
 
-        std::string row;
-        for (int j = 0; j < varCount; j++) {
-            row += (varValues[variables[j]] ? " 1" : " 0") + std::string("  ");
-        }
-        row += "|  " + std::string(result ? "1" : "0");
-        truthTable.push_back(row);
-    }
+    truthTable = expressionTable;
 
     showTruthTable = true;
+    formatTruthTable();
     currentExpression = simplifyExpression();
     showExpression = true;
     setupUITexts();
@@ -742,7 +1181,7 @@ void Simulator::setupUITexts() const {
     std::cout << "setupUITexts: Initialized truthTableTitleText" << std::endl;
 
     truthTableTexts.clear();
-    for (const auto &row : truthTable) {
+    for (const auto &row : truthTableLines) {
         sf::Text rowText(*currentFont);
         rowText.setString(row);
         rowText.setCharacterSize(12);
@@ -758,223 +1197,288 @@ void Simulator::setupUITexts() const {
     std::cout << "setupUITexts: Initialized inputFieldText" << std::endl;
 }
 
-void Simulator::toggleInputField() {
-    showInputField = !showInputField;
-    if (!showInputField) {
-        inputExpression.clear();
-    }
-    setupUITexts();
-}
-
-void Simulator::removeDuplicateVariables() {
-    std::sort(variables.begin(), variables.end());
-    variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
-}
+void Simulator::setTruthTableMessage(const std::string &message) { setTruthTableMessage(std::vector<std::string>{message}); }
 
-bool Simulator::isOperator(char c) { return c == '.' || c == '+' || c == '~' || c == '^'; }
-
-int Simulator::precedence(char op) {
-    if (op == '+') {
-        return 1;
-    }
-    if (op == '.') {
-        return 2;
-    }
-    if (op == '~' || op == '^') {
-        return 3;
-    }
-    return 0;
+void Simulator::setTruthTableMessage(const std::vector<std::string> &lines) {
+    truthTable = TruthTable();
+    truthTableHeader.clear();
+    truthTableLines = lines;
 }
 
-bool Simulator::applyOperation(bool a, bool b, char op) {
-    switch (op) {
-        case '.':
-            return a && b;
-        case '+':
-            return a || b;
-        case '^':
-            return a != b;
-        default:
-            return false;
-    }
+uint64_t Simulator::getTruthTableLineCount() const {
+    return truthTable.empty() ? truthTableLines.size() : 2 + truthTable.getRowCount();
 }
 
-std::string Simulator::infixToPostfix(const std::string &infix) {
-    std::stack<char> s;
-    std::string postfix;
+void Simulator::formatTruthTable() {
+    // Only the rows the panel can show are turned into text
+    truthTableLines.clear();
+    truthTableLines.push_back(truthTableHeader);
+    truthTableLines.push_back(std::string(truthTableHeader.length(), '-'));
 
-    for (char c : infix) {
-        if (std::isalpha(c)) {
-            postfix += c;
-        } else if (c == '(') {
-            s.push(c);
-        } else if (c == ')') {
-            while (!s.empty() && s.top() != '(') {
-                postfix += s.top();
-                s.pop();
-            }
-            s.pop();
-        } else if (isOperator(c)) {
-            while (!s.empty() && precedence(s.top()) >= precedence(c)) {
-                postfix += s.top();
-                s.pop();
-            }
-            s.push(c);
-        }
-    }
-
-    while (!s.empty()) {
-        postfix += s.top();
-        s.pop();
+    uint64_t visibleRows = std::min<uint64_t>(truthTable.getRowCount(), TRUTH_TABLE_VISIBLE_LINES - 2);
+    for (uint64_t row = 0; row < visibleRows; ++row) {
+        truthTableLines.push_back(formatTruthTableRow(row));
     }
-
-    return postfix;
 }
 
-bool Simulator::evaluatePostfix(const std::string &postfix) {
-    std::stack<bool> s;
-
-    for (char c : postfix) {
-        if (std::isalpha(c)) {
-            s.push(varValues[c]);
-        } else if (c == '~') {
-            bool a = s.top();
-            s.pop();
-            s.push(!a);
-        } else {
-            bool b = s.top();
-            s.pop();
-            bool a = s.top();
-            s.pop();
-            s.push(applyOperation(a, b, c));
+std::string Simulator::formatTruthTableRow(uint64_t row) const {
+    std::string text;
+    if (truthTable.getInputOrder() == InputOrder::MSB_FIRST) {
+        // Expression table: variables MSB first, single result column
+        for (size_t j = 0; j < truthTable.getInputCount(); j++) {
+            text += (truthTable.getInput(j, row) ? " 1" : " 0") + std::string("  ");
         }
+        text += "|  " + std::string(truthTable.get(0, row) ? "1" : "0");
+        return text;
     }
 
-    return s.top();
-}
-
-std::string Simulator::getBinaryString(int num, int length) {
-    std::string binary;
-    for (int i = length - 1; i >= 0; i--) {
-        binary += ((num >> i) & 1) ? '1' : '0';
+    for (size_t i = 0; i < truthTable.getInputCount(); ++i) {
+        text += truthTable.getInput(i, row) ? " 1" : " 0";
+        text += "   ";
     }
-    return binary;
-}
-
-bool Simulator::differsByOneBit(const std::string &a, const std::string &b) {
-    int diff = 0;
-    for (size_t i = 0; i < a.size(); i++) {
-        if (a[i] != b[i]) diff++;
-        if (diff > 1) return false;
+    text += " | ";
+    for (size_t i = 0; i < truthTable.getOutputCount(); ++i) {
+        text += truthTable.get(i, row) ? "  1" : "  0";
+        text += "   ";
     }
-    return diff == 1;
+    return text;
 }
 
-std::string Simulator::combineTerms(const std::string &a, const std::string &b) {
-    std::string combined;
-    for (size_t i = 0; i < a.size(); i++) {
-        combined += (a[i] == b[i]) ? a[i] : '-';
+void Simulator::toggleInputField() {
+    showInputField = !showInputField;
+    if (!showInputField) {
+        inputExpression.clear();
     }
-    return combined;
+    setupUITexts();
 }
 
-std::string Simulator::termToExpression(const std::string &term) {
+std::string Simulator::termToExpression(const Cube &term) const {
+    // Expression tables put variable i in row bit n - 1 - i
+    const size_t n = variables.size();
     std::string expr;
-    for (size_t i = 0; i < term.size(); i++) {
-        if (term[i] == '0')
-            expr += "~" + std::string(1, variables[i]) + " . ";
-        else if (term[i] == '1')
-            expr += std::string(1, variables[i]) + " . ";
+    for (size_t i = 0; i < n; i++) {
+        uint64_t bit = uint64_t(1) << (n - 1 - i);
+        if (term.mask & bit) continue;
+        expr += (term.value & bit ? "" : "~") + std::string(1, variables[i]) + " . ";
     }
     if (!expr.empty()) expr = expr.substr(0, expr.size() - 3);
     return expr.empty() ? "1" : expr;
 }
 
 std::string Simulator::simplifyExpression() {
-    if (variables.empty() || minterms.empty()) return "0";
-
-    bool all_true = true, all_false = true;
-    for (bool m : minterms) {
-        if (!m) all_true = false;
-        if (m) all_false = false;
-    }
-    if (all_true) return "1";
-    if (all_false) return "0";
-
-    std::set<std::string> binaryMinterms;
-    for (size_t i = 0; i < minterms.size(); i++) {
-        if (minterms[i]) {
-            binaryMinterms.insert(getBinaryString(i, variables.size()));
-        }
-    }
-
-    std::set<std::string> primeImplicants = binaryMinterms;
-    bool changed;
-    do {
-        changed = false;
-        std::set<std::string> used;
-        std::set<std::string> newImplicants;
-
-        auto it1 = primeImplicants.begin();
-        while (it1 != primeImplicants.end()) {
-            bool combined = false;
-            auto it2 = primeImplicants.begin();
-            while (it2 != primeImplicants.end()) {
-                if (it1 == it2) {
-                    ++it2;
-                    continue;
-                }
-                if (differsByOneBit(*it1, *it2)) {
-                    newImplicants.insert(combineTerms(*it1, *it2));
-                    used.insert(*it1);
-                    used.insert(*it2);
-                    combined = true;
-                    changed = true;
-                }
-                ++it2;
-            }
-            if (!combined && used.find(*it1) == used.end()) {
-                newImplicants.insert(*it1);
-            }
-            ++it1;
+    if (variables.empty() || expressionTable.empty()) {
+        simplifiedExpression = "0";
+    } else if (expressionTable.isConstant(0, true)) {
+        simplifiedExpression = "1";
+    } else if (expressionTable.isConstant(0, false)) {
+        simplifiedExpression = "0";
+    } else {
+        MinimizeOptions options;
+        options.mode = minimizeMode;
+        options.timeBudget = std::chrono::milliseconds(MINIMIZE_TIME_BUDGET_MS);
+        MinimizeMode used;
+        simplifiedExpression = termsToExpression(minimizeCover(expressionTable, 0, options, &used));
+        if (minimizeMode == MinimizeMode::EXACT && used != MinimizeMode::EXACT) {
+            std::cout << "Exact minimization is out of reach for " << variables.size() << " variables, used the heuristic cover" << std::endl;
         }
+    }
+    return simplifiedExpression;
+}
 
-        primeImplicants = newImplicants;
-    } while (changed);
+std::string Simulator::termsToExpression(std::vector<Cube> terms) const {
+    // List terms in the order of their '-'/'0'/'1' patterns, first variable first
+    const size_t n = variables.size();
+    auto rank = [](const Cube &cube, uint64_t bit) { return (cube.mask & bit) ? 0 : (cube.value & bit) ? 2 : 1; };
+    std::sort(terms.begin(), terms.end(), [&](const Cube &a, const Cube &b) {
+        for (size_t i = n; i-- > 0;) {
+            uint64_t bit = uint64_t(1) << i;
+            if (rank(a, bit) != rank(b, bit)) return rank(a, bit) < rank(b, bit);
+        }
+        return false;
+    });
 
-    std::string result;
-    for (const std::string &term : primeImplicants) {
-        std::string expr = termToExpression(term);
-        if (!expr.empty()) result += "(" + expr + ") + ";
+    // Two variables, terms ~A.B and A.~B
+    if (n == 2 && terms.size() == 2 && terms[0] == Cube{1, 0} && terms[1] == Cube{2, 0}) {
+        return std::string(1, variables[0]) + " ^ " + std::string(1, variables[1]);
     }
 
+    std::string result;
+    for (const Cube &term : terms) {
+        result += "(" + termToExpression(term) + ") + ";
+    }
     if (!result.empty()) result = result.substr(0, result.size() - 3);
+    return result.empty() ? "0" : result;
+}
 
-    if (primeImplicants.size() == 2) {
-        auto it = primeImplicants.begin();
-        std::string term1 = *it;
-        std::string term2 = *(++it);
-
-        bool isXOR = true;
-        for (size_t i = 0; i < term1.size(); i++) {
-            if ((term1[i] == '0' && term2[i] != '1') || (term1[i] == '1' && term2[i] != '0') || (term2[i] == '0' && term1[i] != '1') ||
-                (term2[i] == '1' && term1[i] != '0')) {
-                isXOR = false;
-                break;
-            }
-        }
-        if (isXOR) {
-            return std::string(1, variables[0]) + " ^ " + std::string(1, variables[1]);
-        }
+std::string Simulator::simplifyWideExpression() {
+    // Variable j goes to BDD variable n - 1 - j, the row bit termToExpression() reads
+    const size_t n = variables.size();
+    std::vector<uint32_t> variableOf(n);
+    for (size_t j = 0; j < n; ++j) variableOf[j] = static_cast<uint32_t>(n - 1 - j);
+
+    BddManager manager;
+    BddManager::Edge f = buildExpressionBdd(manager, compiledExpression, variableOf);
+    std::vector<Cube> cover;
+    if (f == BddManager::INVALID || !manager.isop(f, static_cast<uint32_t>(n), cover)) {
+        simplifiedExpression.clear();
+        return "Cannot simplify: " + manager.getError();
     }
-
-    return result.empty() ? "0" : result;
+    simplifiedExpression = f == BddManager::ONE ? "1" : termsToExpression(cover);
+    return simplifiedExpression;
 }
 
 void Simulator::readExpression() {
     // Implemented via UI input field, not console
 }
 
+void Simulator::generateCircuit(bool minimized) {
+    const std::string &source = minimized ? simplifiedExpression : expression;
+    if (source.empty()) {
+        std::cout << (minimized ? "No simplified expression" : "No expression entered") << ", nothing to generate" << std::endl;
+        return;
+    }
+    generateCircuitFromExpression(source);
+}
+
 void Simulator::generateCircuitFromExpression(const std::string &expr) {
-    // Placeholder for future implementation
+    CompiledExpression compiled;
+    if (!compiled.compile(expr)) {
+        std::cout << "Cannot generate a circuit: " << compiled.getError() << std::endl;
+        return;
+    }
+
+    // Letter k is input k, as E, B and V read them, so every letter from A up to the last
+    // one used gets an INPUT gate even if the expression skips it
+    const std::vector<char> &letters = compiled.getVariables();
+    if (std::any_of(letters.begin(), letters.end(), [](char c) { return c < 'A' || c > 'Z'; })) {
+        std::cout << "Cannot generate a circuit: inputs are named by the letters A to Z" << std::endl;
+        return;
+    }
+    const size_t inputCount = static_cast<size_t>(letters.back() - 'A') + 1;
+
+    // Hash-consed DAG: one node per distinct gate type and fan-in, children before parents.
+    // Inputs are nodes 0..n-1 so the INPUT gates come out in letter order.
+    struct Node {
+        GateType type;
+        uint32_t a, b;
+        uint32_t level;
+    };
+    std::vector<Node> nodes;
+    nodes.reserve(inputCount + compiled.getCode().size());
+    for (size_t j = 0; j < inputCount; ++j) nodes.push_back({GateType::INPUT, 0, 0, 0});
+
+    std::unordered_map<uint64_t, uint32_t> unique;
+    unique.reserve(compiled.getCode().size());
+    auto make = [&](GateType type, uint32_t a, uint32_t b) {
+        if (type != GateType::NOT && a > b) std::swap(a, b);
+        if ((type == GateType::AND || type == GateType::OR) && a == b) return a;
+        uint64_t key = uint64_t(type) << 58 | uint64_t(a) << 29 | b;
+        auto found = unique.find(key);
+        if (found != unique.end()) return found->second;
+        uint32_t level = 1 + std::max(nodes[a].level, type == GateType::NOT ? 0 : nodes[b].level);
+        nodes.push_back({type, a, b, level});
+        unique.emplace(key, static_cast<uint32_t>(nodes.size() - 1));
+        return static_cast<uint32_t>(nodes.size() - 1);
+    };
+    // Inverters fold into the gate they follow: ~~x = x, ~(a.b) = NAND and so on
+    auto negate = [&](uint32_t x) {
+        const Node node = nodes[x];
+        switch (node.type) {
+            case GateType::NOT:
+                return node.a;
+            case GateType::AND:
+                return make(GateType::NAND, node.a, node.b);
+            case GateType::NAND:
+                return make(GateType::AND, node.a, node.b);
+            case GateType::OR:
+                return make(GateType::NOR, node.a, node.b);
+            case GateType::NOR:
+                return make(GateType::OR, node.a, node.b);
+            default:
+                return make(GateType::NOT, x, 0);
+        }
+    };
+
+    using Opcode = CompiledExpression::Opcode;
+    std::vector<uint32_t> stack;
+    for (const CompiledExpression::Instruction &in : compiled.getCode()) {
+        if (in.op == Opcode::VAR) {
+            stack.push_back(static_cast<uint32_t>(letters[in.var] - 'A'));
+        } else if (in.op == Opcode::NOT) {
+            stack.back() = negate(stack.back());
+        } else {
+            uint32_t b = stack.back();
+            stack.pop_back();
+            GateType type = in.op == Opcode::AND ? GateType::AND : in.op == Opcode::OR ? GateType::OR : GateType::XOR;
+            stack.back() = make(type, stack.back(), b);
+        }
+    }
+    const uint32_t root = stack.back();
+
+    // Folding leaves gates nothing reads; keep every input and the cone of the root
+    std::vector<uint8_t> live(nodes.size(), 0);
+    std::fill_n(live.begin(), inputCount, 1);
+    live[root] = 1;
+    for (size_t n = nodes.size(); n-- > inputCount;) {
+        if (!live[n]) continue;
+        live[nodes[n].a] = 1;
+        if (nodes[n].type != GateType::NOT) live[nodes[n].b] = 1;
+    }
+
+    // Levelized columns, the OUTPUT one column right of the root. Within a column, gates
+    // are sorted by the mean row of their fan-in to keep wires short and mostly straight.
+    const uint32_t outputLevel = nodes[root].level + 1;
+    std::vector<std::vector<uint32_t>> columns(outputLevel + 1);
+    for (uint32_t n = 0; n < nodes.size(); ++n) {
+        if (live[n]) columns[nodes[n].level].push_back(n);
+    }
+    std::vector<float> row(nodes.size(), 0.f);
+    size_t tallest = 1;
+    for (auto &column : columns) {
+        if (&column != &columns[0]) {
+            auto weight = [&](uint32_t n) { return nodes[n].type == GateType::NOT ? row[nodes[n].a] : (row[nodes[n].a] + row[nodes[n].b]) / 2.f; };
+            std::stable_sort(column.begin(), column.end(), [&](uint32_t x, uint32_t y) { return weight(x) < weight(y); });
+        }
+        for (size_t r = 0; r < column.size(); ++r) row[column[r]] = static_cast<float>(r);
+        tallest = std::max(tallest, column.size());
+    }
+
+    // Replace the circuit in one batch: every gate and wire, the OUTPUT included, is appended to reserved storage
+    size_t gateCount = 1, wireCount = 1;
+    for (uint32_t n = 0; n < nodes.size(); ++n) {
+        if (!live[n]) continue;
+        ++gateCount;
+        wireCount += n < inputCount ? 0 : nodes[n].type == GateType::NOT ? 1 : 2;
+    }
+    cancelSelection();
+    gates.clear();
+    wires.clear();
+    gates.reserve(gateCount);
+    wires.reserve(wireCount);
+
+    const sf::Vector2f origin{WindowConfig::getPaletteSize().x + GENERATED_MARGIN, GENERATED_MARGIN};
+    auto place = [&](size_t level, size_t r, size_t height) {
+        float y = static_cast<float>(r) + (static_cast<float>(tallest) - static_cast<float>(height)) / 2.f;
+        return origin + sf::Vector2f{level * GENERATED_COLUMN_SPACING, y * GENERATED_ROW_SPACING};
+    };
+    std::vector<uint32_t> gateOf(nodes.size(), 0);
+    for (size_t level = 0; level < outputLevel; ++level) {
+        const std::vector<uint32_t> &column = columns[level];
+        for (size_t r = 0; r < column.size(); ++r) {
+            const Node &node = nodes[column[r]];
+            gateOf[column[r]] = static_cast<uint32_t>(gates.size());
+            gates.emplace_back(node.type, place(level, r, column.size()));
+            if (node.type == GateType::INPUT) continue;
+            wires.emplace_back(gateOf[node.a], -1, gates.size() - 1, 0);
+            if (node.type != GateType::NOT) wires.emplace_back(gateOf[node.b], -1, gates.size() - 1, 1);
+        }
+    }
+    gates.emplace_back(GateType::OUTPUT, place(outputLevel, 0, 1));
+    wires.emplace_back(gateOf[root], -1, gates.size() - 1, 0);
+
+    inputCounter = static_cast<int>(inputCount);
+    outputCounter = 1;
+    structureDirty = true;
+    std::cout << "Generated " << gates.size() << " gates and " << wires.size() << " wires in " << outputLevel << " levels from: " << expr
+              << std::endl;
 }
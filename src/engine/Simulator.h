@@ -3,20 +3,48 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <limits>
 #include <map>
 #include <memory>
-#include <set>
-#include <stack>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "Bdd.h"
+#include "BytecodeEvaluator.h"
+#include "CircuitEvaluator.h"
+#include "CycleSimulation.h"
+#include "Equivalence.h"
+#include "Expression.h"
 #include "Gate.h"
+#include "Minimizer.h"
+#include "NativeEvaluator.h"
+#include "Netlist.h"
+#include "TruthTable.h"
+#include "TruthTableExporter.h"
 #include "Wire.h"
 
+// Back end used for pattern-parallel truth table generation and export
+enum class EvaluatorBackend { INTERPRETER, BYTECODE, NATIVE, AIG };
+
 class Simulator {
    public:
+    ~Simulator();
+
+    static constexpr size_t PATTERN_BLOCK_WORDS = 8;        // 512 combinations per pattern-parallel pass
+    static constexpr size_t TRUTH_TABLE_CHUNK_BLOCKS = 16;  // pattern blocks per worker task
+    static constexpr size_t TRUTH_TABLE_VISIBLE_LINES = 15;
+    static constexpr size_t MAX_TABLE_INPUTS = 30;  // larger tables are streamed to disk with exportTruthTable()
+    static constexpr int MINIMIZE_TIME_BUDGET_MS = 2000;
+    static constexpr int EQUIVALENCE_TIME_BUDGET_MS = 10000;
+    static constexpr uint64_t MAX_TIMED_TICKS = 100000;  // per input toggle in analyzeHazards()
+    static constexpr uint64_t BENCHMARK_CYCLES = 1000000;  // headless clock cycles timed by stepClock(true)
+    static constexpr float GENERATED_COLUMN_SPACING = 120.f;  // generated circuits: one column per logic level
+    static constexpr float GENERATED_ROW_SPACING = 80.f;
+    static constexpr float GENERATED_MARGIN = 60.f;
+
     void handleEvent(const sf::Event &event, const sf::RenderWindow &window, const sf::View &view, GateType selectedGate);
     void update();
     void draw(sf::RenderWindow &window) const;
@@ -25,7 +53,17 @@ class Simulator {
     void readExpression();
     void generateTruthTable();
     void generateExpressionTruthTable();
+    void exportTruthTable(ExportFormat format);
+    void cycleEvaluatorBackend();
+    void cycleMinimizeMode();
     std::string simplifyExpression();  // Changed from void to std::string
+    void analyzeWithBdd();
+    void analyzeHazards();
+    void stepClock(bool benchmark);
+    void verifyAgainstExpression();
+    void saveReferenceCircuit();
+    void verifyAgainstReference();
+    void generateCircuit(bool minimized);
     void generateLogicalExpression();
     void clearCircuit();
     void deleteSelectedGates();
@@ -38,20 +76,15 @@ class Simulator {
    private:
     std::string expression;
     std::vector<char> variables;
-    std::map<char, bool> varValues;
-    std::vector<bool> minterms;
-
-    void removeDuplicateVariables();
-    bool isOperator(char c);
-    int precedence(char op);
-    bool applyOperation(bool a, bool b, char op);
-    std::string infixToPostfix(const std::string &infix);
-    bool evaluatePostfix(const std::string &postfix);
-    std::string getBinaryString(int num, int length);
-    bool differsByOneBit(const std::string &a, const std::string &b);
-    std::string combineTerms(const std::string &a, const std::string &b);
-    std::string termToExpression(const std::string &term);
-    void generateCircuitFromExpression(const std::string &expr);  // Changed from std::string to void
+    CompiledExpression compiledExpression;
+    MinimizeMode minimizeMode = MinimizeMode::AUTO;
+    TruthTable expressionTable;  // minterms of the typed expression
+    std::string simplifiedExpression;  // last result of simplifyExpression(), what Shift+G generates
+
+    std::string termToExpression(const Cube &term) const;
+    std::string termsToExpression(std::vector<Cube> terms) const;
+    std::string simplifyWideExpression();
+    void generateCircuitFromExpression(const std::string &expr);
 
     std::vector<Gate> gates;
     std::vector<Wire> wires;
@@ -60,8 +93,63 @@ class Simulator {
     bool selectingSource = true;
     std::vector<size_t> selectedGates;
 
+    Netlist netlist;
+    Netlist referenceCircuit;  // snapshot taken by saveReferenceCircuit()
+    bool referenceSaved = false;
+    std::vector<uint8_t> signals;
+    std::vector<uint32_t> changedGates;
+
+    // Full evaluation runs a bytecode program that stores every gate (the netlist
+    // interpreter if the circuit is too wide for it)
+    BytecodeEvaluator circuitProgram;
+    bool circuitProgramReady = false;
+    std::vector<uint64_t> signalWords;
+    std::vector<uint64_t> circuitRegisters;
+    CycleState cycleState = CycleState::STABLE;  // of the last evaluation, reported when it changes
+
+    // Circuits with clocks or registers are evaluated by a cycle simulation instead, created on
+    // the first evaluation after a rebuild from the register states kept in the gates
+    std::unique_ptr<CycleSimulation> sequential;
+
+    // Truth table export running on a worker thread, polled by update()
+    struct ExportJob {
+        Netlist netlist;
+        std::unique_ptr<CircuitEvaluator> evaluator;
+        std::unique_ptr<TruthTableExporter> exporter;
+        std::string path;
+        std::thread thread;
+        std::atomic<bool> finished{false};
+        bool ok = false;
+    };
+    std::unique_ptr<ExportJob> exportJob;
+    int exportPercent = -1;  // last progress shown
+
+    // Native back end compiling on a worker thread, polled by update()
+    struct NativeBuild {
+        Netlist netlist;
+        uint64_t version = 0;  // netlistVersion it was started for
+        std::unique_ptr<NativeEvaluator> native;
+        std::thread thread;
+        std::atomic<bool> finished{false};
+        bool ok = false;
+    };
+    std::unique_ptr<NativeBuild> nativeBuild;
+    uint64_t netlistVersion = 0;  // bumped by every rebuild in compileNetlist()
+
+    // Built lazily for the current netlist by getEvaluator(); null until then
+    EvaluatorBackend evaluatorBackend = EvaluatorBackend::INTERPRETER;
+    std::unique_ptr<CircuitEvaluator> evaluator;
+
+    // Change tracking for update(): structure = gates/wires added or removed,
+    // state = signal values need a full evaluation, geometry = wire endpoints need layout
+    bool structureDirty = true;
+    bool stateDirty = true;
+    bool geometryDirty = true;
+
     std::string currentExpression;
-    std::vector<std::string> truthTable;
+    TruthTable truthTable;
+    std::string truthTableHeader;
+    std::vector<std::string> truthTableLines;  // header, separator and the visible rows, or a status message
     bool showTruthTable = false;
     bool showExpression = false;
     bool showInputField = false;
@@ -78,12 +166,24 @@ class Simulator {
     int inputCounter = 0;
     int outputCounter = 0;
 
+    void compileNetlist();
+    const CircuitEvaluator &getEvaluator();
+    void pollExport();
+    void startNativeBuild();
+    void pollNativeBuild();
     void evaluateCircuit();
+    void setCycleState(CycleState state);
+    void layoutWires();
+    void propagateInput(size_t gateIndex);
     std::vector<size_t> getInputGates() const;
     std::vector<size_t> getOutputGates() const;
-    std::string generateExpressionForGate(size_t gateIndex, std::map<size_t, std::string> &expressions) const;
     std::string getGateSymbol(GateType type) const;
     void removeGate(size_t gateIndex);
     void removeWiresConnectedToGate(size_t gateIndex);
     void setupUITexts() const;
+    void setTruthTableMessage(const std::string &message);
+    void setTruthTableMessage(const std::vector<std::string> &lines);
+    void formatTruthTable();
+    std::string formatTruthTableRow(uint64_t row) const;
+    uint64_t getTruthTableLineCount() const;
 };
\ No newline at end of file
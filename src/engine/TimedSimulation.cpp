@@ -0,0 +1,197 @@
+// engine/TimedSimulation.cpp
+
+#include "TimedSimulation.h"
+
+#include <algorithm>
+
+void TimingWheel::reset(uint64_t start) {
+    for (auto &level : slots) {
+        for (auto &slot : level) slot.clear();
+    }
+    for (auto &level : occupied) std::fill(std::begin(level), std::end(level), 0);
+    overflow.clear();
+    current = start;
+    pendingCount = 0;
+}
+
+void TimingWheel::schedule(const Event &event) {
+    place(event);
+    ++pendingCount;
+}
+
+void TimingWheel::place(const Event &event) {
+    // The highest bit where the event time and now differ picks the level
+    const uint64_t diff = event.time ^ current;
+    const unsigned level = diff == 0 ? 0 : (63 - __builtin_clzll(diff)) / SLOT_BITS;
+    if (level >= LEVELS) {
+        overflow.push_back(event);
+        return;
+    }
+    const unsigned slot = static_cast<unsigned>(event.time >> (level * SLOT_BITS)) & (SLOTS - 1);
+    slots[level][slot].push_back(event);
+    occupied[level][slot / 64] |= uint64_t(1) << (slot % 64);
+}
+
+int TimingWheel::nextOccupied(unsigned level, unsigned from) const {
+    for (unsigned word = from / 64; word < SLOTS / 64; ++word) {
+        uint64_t bits = occupied[level][word];
+        if (word == from / 64) bits &= ~uint64_t(0) << (from % 64);
+        if (bits) return static_cast<int>(word * 64 + __builtin_ctzll(bits));
+    }
+    return -1;
+}
+
+void TimingWheel::cascade(unsigned level, unsigned slot) {
+    std::vector<Event> events;
+    events.swap(slots[level][slot]);
+    occupied[level][slot / 64] &= ~(uint64_t(1) << (slot % 64));
+    for (const Event &event : events) place(event);
+    // Keep the capacity with the slot for the next round
+    events.clear();
+    if (slots[level][slot].capacity() < events.capacity()) slots[level][slot].swap(events);
+}
+
+bool TimingWheel::pop(uint64_t limit, std::vector<Event> &out) {
+    out.clear();
+    while (pendingCount > 0) {
+        // Level 0 covers the current block one tick per slot
+        int slot = nextOccupied(0, static_cast<unsigned>(current) & (SLOTS - 1));
+        if (slot >= 0) {
+            uint64_t time = (current & ~uint64_t(SLOTS - 1)) | static_cast<unsigned>(slot);
+            if (time > limit) return false;
+            current = time;
+            out.swap(slots[0][slot]);
+            occupied[0][slot / 64] &= ~(uint64_t(1) << (slot % 64));
+            pendingCount -= out.size();
+            return true;
+        }
+
+        // Nothing left below: jump to the start of the next occupied slot higher up. The slot
+        // holding now is always empty above level 0, so the search starts after it.
+        bool moved = false;
+        for (unsigned level = 1; level < LEVELS && !moved; ++level) {
+            const unsigned shift = level * SLOT_BITS;
+            const unsigned index = static_cast<unsigned>(current >> shift) & (SLOTS - 1);
+            if (index + 1 >= SLOTS) continue;
+            slot = nextOccupied(level, index + 1);
+            if (slot < 0) continue;
+            const uint64_t upper = shift + SLOT_BITS >= 64 ? 0 : (current >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+            const uint64_t start = upper | (uint64_t(slot) << shift);
+            if (start > limit) return false;
+            current = start;
+            cascade(level, static_cast<unsigned>(slot));
+            moved = true;
+        }
+        if (moved) continue;
+
+        // Only far events remain
+        uint64_t earliest = overflow.front().time;
+        for (const Event &event : overflow) earliest = std::min(earliest, event.time);
+        if (earliest > limit) return false;
+        current = earliest;
+        std::vector<Event> events;
+        events.swap(overflow);
+        for (const Event &event : events) place(event);
+    }
+    return false;
+}
+
+uint32_t defaultGateDelay(GateType type) {
+    switch (type) {
+        case GateType::INPUT:
+        case GateType::OUTPUT:
+        case GateType::DFF:
+        case GateType::LATCH:
+        case GateType::CLOCK:
+            return 0;
+        case GateType::NOT:
+            return 1;
+        case GateType::AND:
+        case GateType::OR:
+        case GateType::NAND:
+        case GateType::NOR:
+            return 2;
+        case GateType::XOR:
+            return 3;
+    }
+    return 1;
+}
+
+TimedSimulation::TimedSimulation(const Netlist &netlist) : netlist(netlist) {
+    const uint32_t n = static_cast<uint32_t>(netlist.gateCount());
+    const uint32_t *fanouts = netlist.fanoutBegin(0);
+    gateStates.resize(n + 1);
+    for (uint32_t g = 0; g < n; ++g) {
+        GateState &state = gateStates[g];
+        const uint32_t *pin = netlist.faninBegin(g);
+        const uint32_t *end = netlist.faninEnd(g);
+        state.in0 = pin != end ? pin[0] : netlist.constZero();
+        state.in1 = end - pin > 1 ? pin[1] : state.in0;
+        state.fanout = static_cast<uint32_t>(netlist.fanoutBegin(g) - fanouts);
+        state.delay = defaultGateDelay(netlist.getType(g));
+        state.truth = Netlist::truthTable(netlist.getType(g));
+        if (Gate::isSource(netlist.getType(g))) {
+            // Reading itself through a buffer, a source keeps whatever value it was given
+            state.in0 = state.in1 = g;
+            state.truth = Netlist::truthTable(GateType::OUTPUT);
+        }
+        state.output = netlist.getType(g) == GateType::OUTPUT;
+    }
+    if (n > 0) gateStates[n].fanout = static_cast<uint32_t>(netlist.fanoutEnd(n - 1) - fanouts);
+    values.assign(netlist.signalCount(), 0);
+    wheel.reset(0);
+}
+
+void TimedSimulation::reset(const std::vector<uint8_t> &state) {
+    values = state;
+    values[netlist.constZero()] = 0;
+    for (uint32_t g = 0; g < netlist.gateCount(); ++g) {
+        gateStates[g].projected = values[g];
+        gateStates[g].stamp = 0;
+    }
+    batch = 0;
+    transitions.clear();
+    wheel.reset(0);
+}
+
+void TimedSimulation::setInput(uint32_t input, bool value, uint64_t time) {
+    if (gateStates[input].projected == value) return;
+    gateStates[input].projected = value;
+    wheel.schedule({time, input, static_cast<uint8_t>(value)});
+}
+
+size_t TimedSimulation::run(uint64_t until) {
+    if (netlist.gateCount() == 0) return 0;
+    const uint32_t *fanouts = netlist.fanoutBegin(0);
+    uint8_t *v = values.data();
+
+    size_t events = 0;
+    while (wheel.pop(until, due)) {
+        const uint64_t time = wheel.now();
+        events += due.size();
+
+        // Apply everything due now, then evaluate each affected gate once
+        ++batch;
+        touched.clear();
+        for (const TimingWheel::Event &event : due) {
+            if (v[event.gate] == event.value) continue;
+            v[event.gate] = event.value;
+            const GateState &source = gateStates[event.gate];
+            if (source.output) transitions.push_back({time, event.gate, event.value});
+            for (const uint32_t *dst = fanouts + source.fanout; dst != fanouts + gateStates[event.gate + 1].fanout; ++dst) {
+                if (gateStates[*dst].stamp == batch) continue;
+                gateStates[*dst].stamp = batch;
+                touched.push_back(*dst);
+            }
+        }
+
+        for (uint32_t g : touched) {
+            GateState &state = gateStates[g];
+            const uint8_t next = (state.truth >> (v[state.in0] * 2 + v[state.in1])) & 1;
+            if (next == state.projected) continue;
+            state.projected = next;
+            wheel.schedule({time + state.delay, g, next});
+        }
+    }
+    return events;
+}
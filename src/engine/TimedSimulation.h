@@ -0,0 +1,110 @@
+// engine/TimedSimulation.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Netlist.h"
+
+// Hierarchical timing wheel: LEVELS wheels of SLOTS slots, where a slot of level k spans
+// SLOTS^k ticks. An event goes to the lowest level whose span still separates it from the
+// current time, and higher slots are cascaded down as time reaches them, so scheduling and
+// popping are constant time per event. Occupancy bitmaps let idle stretches be skipped.
+// Times beyond the top level wait in an overflow list.
+class TimingWheel {
+   public:
+    static constexpr unsigned SLOT_BITS = 8;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr unsigned LEVELS = 4;
+
+    struct Event {
+        uint64_t time;
+        uint32_t gate;
+        uint8_t value;
+    };
+
+    void reset(uint64_t start);
+    uint64_t now() const { return current; }
+    size_t pending() const { return pendingCount; }
+
+    // time must not be earlier than now()
+    void schedule(const Event &event);
+
+    // Moves to the earliest pending time if it is not later than limit and swaps the events
+    // due then into out (out is cleared first). Returns false, leaving now() alone, otherwise.
+    bool pop(uint64_t limit, std::vector<Event> &out);
+
+   private:
+    uint64_t current = 0;
+    size_t pendingCount = 0;
+    std::vector<Event> slots[LEVELS][SLOTS];
+    uint64_t occupied[LEVELS][SLOTS / 64] = {};
+    std::vector<Event> overflow;
+
+    void place(const Event &event);
+    int nextOccupied(unsigned level, unsigned from) const;
+    void cascade(unsigned level, unsigned slot);
+};
+
+// Transport-delay gate simulation on a timing wheel. Every gate has a delay in ticks
+// (defaultGateDelay() of its type unless set per instance); a gate whose inputs change is
+// re-evaluated and, if its projected output differs, schedules the new value after its
+// delay. Pulses shorter than a delay are kept, so glitches and hazards show up as extra
+// output transitions. Loops need no special handling: events just go round them. Clocks
+// and registers are not clocked here; like inputs they keep the value they start with.
+class TimedSimulation {
+   public:
+    struct Transition {
+        uint64_t time;
+        uint32_t gate;
+        uint8_t value;
+    };
+
+    explicit TimedSimulation(const Netlist &netlist);
+
+    void setDelay(uint32_t gate, uint32_t ticks) { gateStates[gate].delay = ticks; }
+    uint32_t getDelay(uint32_t gate) const { return gateStates[gate].delay; }
+
+    // Starts at time 0 from a settled state, e.g. one from Netlist::evaluate()
+    void reset(const std::vector<uint8_t> &values);
+
+    // Schedules an input change; time must not be earlier than now()
+    void setInput(uint32_t input, bool value, uint64_t time);
+
+    // Processes every event up to and including `until`, returning the number of events
+    size_t run(uint64_t until);
+
+    uint64_t now() const { return wheel.now(); }
+    bool idle() const { return wheel.pending() == 0; }
+    uint8_t value(uint32_t gate) const { return values[gate]; }
+
+    // Changes of OUTPUT gates since reset()
+    const std::vector<Transition> &getTransitions() const { return transitions; }
+
+   private:
+    // Everything run() touches per gate in one record; entry gateCount() ends the last fan-out
+    // range. Gates have at most two pins, so a gate is a 4-entry truth table indexed by
+    // in0 * 2 + in1 and evaluates without branches.
+    struct GateState {
+        uint32_t in0;
+        uint32_t in1;
+        uint32_t fanout;  // first gate in the netlist fan-out array
+        uint32_t delay;
+        uint32_t stamp;     // batch in which the gate was last queued for evaluation
+        uint8_t truth;      // bit in0 * 2 + in1 is the output
+        uint8_t output;     // OUTPUT gates record their transitions
+        uint8_t projected;  // value after the last scheduled event
+    };
+
+    const Netlist &netlist;
+    std::vector<GateState> gateStates;
+    std::vector<uint8_t> values;
+    uint32_t batch = 0;
+    TimingWheel wheel;
+    std::vector<TimingWheel::Event> due;
+    std::vector<uint32_t> touched;
+    std::vector<Transition> transitions;
+};
+
+uint32_t defaultGateDelay(GateType type);
@@ -0,0 +1,91 @@
+// engine/TruthTable.cpp
+
+#include "TruthTable.h"
+
+#include <algorithm>
+
+TruthTable::TruthTable(size_t inputCount, size_t outputCount, InputOrder order) : inputCount(inputCount), outputCount(outputCount), order(order) {
+    bits.assign(outputCount * wordCount(), 0);
+}
+
+uint64_t TruthTable::tailMask() const {
+    uint64_t rows = getRowCount() % 64;
+    return rows == 0 ? ~uint64_t(0) : (uint64_t(1) << rows) - 1;
+}
+
+void TruthTable::set(size_t output, uint64_t row, bool value) {
+    uint64_t &word = column(output)[row / 64];
+    uint64_t bit = uint64_t(1) << (row % 64);
+    word = value ? (word | bit) : (word & ~bit);
+}
+
+uint64_t TruthTable::popcount(size_t output) const {
+    const uint64_t *words = column(output);
+    uint64_t count = 0;
+    for (size_t w = 0; w < wordCount(); ++w) count += static_cast<uint64_t>(__builtin_popcountll(words[w]));
+    return count;
+}
+
+bool TruthTable::isConstant(size_t output, bool value) const {
+    uint64_t ones = popcount(output);
+    return value ? ones == getRowCount() : ones == 0;
+}
+
+TruthTable TruthTable::cofactor(size_t input, bool value) const {
+    if (inputCount == 0 || input >= inputCount) return *this;
+
+    TruthTable result(inputCount - 1, outputCount, order);
+    const unsigned shift = inputShift(input);
+    const uint64_t lowMask = (uint64_t(1) << shift) - 1;
+
+    for (size_t out = 0; out < outputCount; ++out) {
+        const uint64_t *src = column(out);
+        uint64_t *dst = result.column(out);
+
+        if (shift >= 6) {
+            // The fixed input selects whole words: copy runs of 2^(shift-6) words
+            const size_t run = size_t(1) << (shift - 6);
+            const size_t offset = value ? run : 0;
+            for (size_t w = 0; w < result.wordCount(); ++w) {
+                dst[w] = src[(w / run) * 2 * run + offset + w % run];
+            }
+        } else {
+            for (uint64_t row = 0; row < result.getRowCount(); ++row) {
+                uint64_t srcRow = ((row & ~lowMask) << 1) | (uint64_t(value) << shift) | (row & lowMask);
+                if ((src[srcRow / 64] >> (srcRow % 64)) & 1) dst[row / 64] |= uint64_t(1) << (row % 64);
+            }
+        }
+    }
+    return result;
+}
+
+TruthTable TruthTable::operator&(const TruthTable &other) const {
+    TruthTable result = *this;
+    for (size_t i = 0; i < bits.size(); ++i) result.bits[i] &= other.bits[i];
+    return result;
+}
+
+TruthTable TruthTable::operator|(const TruthTable &other) const {
+    TruthTable result = *this;
+    for (size_t i = 0; i < bits.size(); ++i) result.bits[i] |= other.bits[i];
+    return result;
+}
+
+TruthTable TruthTable::operator^(const TruthTable &other) const {
+    TruthTable result = *this;
+    for (size_t i = 0; i < bits.size(); ++i) result.bits[i] ^= other.bits[i];
+    return result;
+}
+
+TruthTable TruthTable::operator~() const {
+    TruthTable result = *this;
+    for (auto &word : result.bits) word = ~word;
+
+    // Keep the padding past the last row at 0
+    for (size_t out = 0; out < outputCount; ++out) result.column(out)[wordCount() - 1] &= tailMask();
+    return result;
+}
+
+bool TruthTable::operator==(const TruthTable &other) const {
+    return inputCount == other.inputCount && outputCount == other.outputCount && order == other.order && bits == other.bits;
+}
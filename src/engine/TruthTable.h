@@ -0,0 +1,69 @@
+// engine/TruthTable.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// How a row index maps to input values: LSB_FIRST gives input i bit i of the row
+// (circuit tables), MSB_FIRST gives the first input the highest bit (expression tables).
+enum class InputOrder { LSB_FIRST, MSB_FIRST };
+
+// Bit-packed truth table. Every output column stores one bit per row in 64-bit
+// words, so a 24-input table takes 2 MB per output. Input columns are implied by
+// the row index and never stored.
+class TruthTable {
+   private:
+    size_t inputCount = 0;
+    size_t outputCount = 0;
+    InputOrder order = InputOrder::LSB_FIRST;
+    std::vector<uint64_t> bits;  // output columns back to back, wordCount() words each; padding bits stay 0
+
+    uint64_t tailMask() const;
+    unsigned inputShift(size_t input) const { return order == InputOrder::LSB_FIRST ? input : inputCount - 1 - input; }
+
+   public:
+    TruthTable() = default;
+    TruthTable(size_t inputCount, size_t outputCount, InputOrder order = InputOrder::LSB_FIRST);
+
+    bool empty() const { return outputCount == 0; }
+    size_t getInputCount() const { return inputCount; }
+    size_t getOutputCount() const { return outputCount; }
+    InputOrder getInputOrder() const { return order; }
+    uint64_t getRowCount() const { return uint64_t(1) << inputCount; }
+    size_t wordCount() const { return static_cast<size_t>((getRowCount() + 63) / 64); }
+
+    bool getInput(size_t input, uint64_t row) const { return (row >> inputShift(input)) & 1; }
+    bool get(size_t output, uint64_t row) const { return (column(output)[row / 64] >> (row % 64)) & 1; }
+    void set(size_t output, uint64_t row, bool value);
+
+    // Packed output column, wordCount() words; bit r % 64 of word r / 64 is row r
+    uint64_t *column(size_t output) { return bits.data() + output * wordCount(); }
+    const uint64_t *column(size_t output) const { return bits.data() + output * wordCount(); }
+
+    // Number of rows where the output is 1
+    uint64_t popcount(size_t output) const;
+    bool isConstant(size_t output, bool value) const;
+
+    // Table over the remaining inputs with `input` fixed to `value`
+    TruthTable cofactor(size_t input, bool value) const;
+
+    // Column-wise operations on tables of the same shape
+    TruthTable operator&(const TruthTable &other) const;
+    TruthTable operator|(const TruthTable &other) const;
+    TruthTable operator^(const TruthTable &other) const;
+    TruthTable operator~() const;
+    bool operator==(const TruthTable &other) const;
+    bool operator!=(const TruthTable &other) const { return !(*this == other); }
+
+    // Calls fn(row) for every row where the output is 1, in increasing row order
+    template <typename Fn>
+    void forEachOnRow(size_t output, Fn fn) const {
+        const uint64_t *words = column(output);
+        for (size_t w = 0; w < wordCount(); ++w) {
+            for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+                fn(uint64_t(w) * 64 + static_cast<uint64_t>(__builtin_ctzll(word)));
+            }
+        }
+    }
+};
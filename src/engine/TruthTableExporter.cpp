@@ -0,0 +1,174 @@
+// engine/TruthTableExporter.cpp
+
+#include "TruthTableExporter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#include "Parallel.h"
+
+namespace {
+
+void appendU32(std::string &buffer, uint32_t value) {
+    for (int i = 0; i < 4; ++i) buffer += static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+void appendU64(std::string &buffer, uint64_t value) {
+    for (int i = 0; i < 8; ++i) buffer += static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+}  // namespace
+
+bool TruthTableExporter::exportTo(const std::string &path, ExportFormat format) {
+    rowsWritten = 0;
+    error.clear();
+
+    if (netlist.getInputs().empty() || netlist.getOutputs().empty()) {
+        error = "No inputs or outputs found";
+        return false;
+    }
+    if (netlist.getInputs().size() > MAX_INPUTS) {
+        error = "Too many inputs to enumerate (max " + std::to_string(MAX_INPUTS) + ")";
+        return false;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        error = "Could not open " + path;
+        return false;
+    }
+
+    columns.assign(netlist.getOutputs().size() * CHUNK_WORDS, 0);
+    workerBlocks.assign(parallelWorkerCount(), {});
+
+    writeHeader(out, format);
+
+    const uint64_t rowCount = getRowCount();
+    const uint64_t chunkRows = CHUNK_WORDS * 64;
+    for (uint64_t firstRow = 0; firstRow < rowCount; firstRow += chunkRows) {
+        if (cancelled) {
+            out.close();
+            std::remove(path.c_str());
+            error = "Export cancelled";
+            return false;
+        }
+        uint64_t rows = std::min(chunkRows, rowCount - firstRow);
+        evaluateChunk(firstRow, rows);
+        writeChunk(out, format, firstRow, rows);
+
+        if (!out) {
+            error = "Write to " + path + " failed";
+            return false;
+        }
+        rowsWritten += rows;
+    }
+
+    writeFooter(out, format);
+    out.flush();
+    if (!out) {
+        error = "Write to " + path + " failed";
+        return false;
+    }
+    return true;
+}
+
+void TruthTableExporter::evaluateChunk(uint64_t firstRow, uint64_t rows) {
+    const auto &inputs = netlist.getInputs();
+    const auto &outputs = netlist.getOutputs();
+    const size_t words = static_cast<size_t>((rows + 63) / 64);
+    const size_t blockWords = std::min(BLOCK_WORDS, words);
+    const size_t blockCount = (words + blockWords - 1) / blockWords;
+
+    parallelFor(blockCount, 16, [&](size_t begin, size_t end, size_t worker) {
+        std::vector<uint64_t> &blocks = workerBlocks[worker];
+        blocks.resize(netlist.signalCount() * blockWords);
+
+        for (size_t block = begin; block < end; ++block) {
+            size_t firstWord = block * blockWords;
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                for (size_t w = 0; w < blockWords; ++w) {
+                    blocks[inputs[i] * blockWords + w] = Netlist::inputPattern(i, firstRow + 64 * (firstWord + w));
+                }
+            }
+
+            evaluator->evaluate(blocks, blockWords);
+
+            size_t count = std::min(blockWords, words - firstWord);
+            for (size_t o = 0; o < outputs.size(); ++o) {
+                std::copy_n(blocks.begin() + outputs[o] * blockWords, count, columns.begin() + o * CHUNK_WORDS + firstWord);
+            }
+        }
+    });
+
+    // Rows past the end of the table must not leak into the last word
+    if (rows % 64 != 0) {
+        uint64_t tail = (uint64_t(1) << (rows % 64)) - 1;
+        for (size_t o = 0; o < outputs.size(); ++o) columns[o * CHUNK_WORDS + words - 1] &= tail;
+    }
+}
+
+void TruthTableExporter::writeHeader(std::ostream &out, ExportFormat format) {
+    const size_t numInputs = netlist.getInputs().size();
+    const size_t numOutputs = netlist.getOutputs().size();
+    buffer.clear();
+
+    switch (format) {
+        case ExportFormat::CSV:
+            for (size_t i = 0; i < numInputs; ++i) buffer += "In" + std::to_string(i) + ",";
+            for (size_t o = 0; o < numOutputs; ++o) buffer += "Out" + std::to_string(o) + (o + 1 < numOutputs ? "," : "\n");
+            break;
+        case ExportFormat::PLA:
+            buffer += ".i " + std::to_string(numInputs) + "\n";
+            buffer += ".o " + std::to_string(numOutputs) + "\n";
+            buffer += ".ilb";
+            for (size_t i = 0; i < numInputs; ++i) buffer += " In" + std::to_string(i);
+            buffer += "\n.ob";
+            for (size_t o = 0; o < numOutputs; ++o) buffer += " Out" + std::to_string(o);
+            buffer += "\n.p " + std::to_string(getRowCount()) + "\n";
+            break;
+        case ExportFormat::BINARY:
+            buffer += "DLTT";
+            appendU32(buffer, 1);
+            appendU32(buffer, static_cast<uint32_t>(numInputs));
+            appendU32(buffer, static_cast<uint32_t>(numOutputs));
+            appendU64(buffer, getRowCount());
+            break;
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+void TruthTableExporter::writeChunk(std::ostream &out, ExportFormat format, uint64_t firstRow, uint64_t rows) {
+    const size_t numInputs = netlist.getInputs().size();
+    const size_t numOutputs = netlist.getOutputs().size();
+    buffer.clear();
+
+    if (format == ExportFormat::BINARY) {
+        const size_t words = static_cast<size_t>((rows + 63) / 64);
+        for (size_t o = 0; o < numOutputs; ++o) {
+            for (size_t w = 0; w < words; ++w) appendU64(buffer, columns[o * CHUNK_WORDS + w]);
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        return;
+    }
+
+    const char separator = format == ExportFormat::CSV ? ',' : '\0';
+    for (uint64_t r = 0; r < rows; ++r) {
+        uint64_t row = firstRow + r;
+        for (size_t i = 0; i < numInputs; ++i) {
+            buffer += ((row >> i) & 1) ? '1' : '0';
+            if (separator) buffer += separator;
+        }
+        if (format == ExportFormat::PLA) buffer += ' ';
+        for (size_t o = 0; o < numOutputs; ++o) {
+            buffer += ((columns[o * CHUNK_WORDS + r / 64] >> (r % 64)) & 1) ? '1' : '0';
+            if (separator && o + 1 < numOutputs) buffer += separator;
+        }
+        buffer += '\n';
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+void TruthTableExporter::writeFooter(std::ostream &out, ExportFormat format) {
+    if (format == ExportFormat::PLA) out << ".e\n";
+}
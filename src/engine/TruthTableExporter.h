@@ -0,0 +1,63 @@
+// engine/TruthTableExporter.h
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "CircuitEvaluator.h"
+#include "Netlist.h"
+
+// CSV:    "In0,...,Out0,..." header, then one "0,1,...,1" line per row
+// PLA:    Berkeley PLA (.i/.o/.ilb/.ob/.p ... .e), one "<inputs> <outputs>" line per row
+// BINARY: "DLTT", u32 version, u32 inputs, u32 outputs, u64 rows (all little-endian), then for
+//         every chunk of CHUNK_WORDS * 64 rows and every output the chunk's packed column words
+//         (u64 little-endian, bit r % 64 of word r / 64 is row r, padding bits 0)
+enum class ExportFormat { CSV, PLA, BINARY };
+
+// Streams the exhaustive truth table of a compiled netlist straight to disk.
+// Rows are generated and written in fixed-size chunks, so memory stays bounded
+// no matter how many inputs the circuit has. Row r assigns bit i of r to input i.
+// exportTo() may run on a worker thread while another thread polls getRowsWritten()
+// and calls cancel().
+class TruthTableExporter {
+   public:
+    static constexpr size_t CHUNK_WORDS = 1024;  // 65536 rows per chunk
+    static constexpr size_t BLOCK_WORDS = 8;     // pattern block width per evaluation
+    static constexpr size_t MAX_INPUTS = 63;     // row indices are 64-bit
+
+    // evaluator defaults to the netlist interpreter and must outlive the exporter
+    explicit TruthTableExporter(const Netlist &netlist, const CircuitEvaluator *evaluator = nullptr)
+        : netlist(netlist), interpreter(netlist), evaluator(evaluator ? evaluator : &interpreter) {}
+
+    // Replaces the evaluator before exportTo(), e.g. once the thread running it has built one
+    void setEvaluator(const CircuitEvaluator *backend) { evaluator = backend ? backend : &interpreter; }
+
+    bool exportTo(const std::string &path, ExportFormat format);
+
+    // Stops exportTo() after the chunk it is writing and removes the partial file
+    void cancel() { cancelled = true; }
+
+    uint64_t getRowCount() const { return uint64_t(1) << netlist.getInputs().size(); }
+    uint64_t getRowsWritten() const { return rowsWritten; }
+    const std::string &getError() const { return error; }
+
+   private:
+    const Netlist &netlist;
+    InterpretedEvaluator interpreter;
+    const CircuitEvaluator *evaluator;
+    std::atomic<uint64_t> rowsWritten{0};
+    std::atomic<bool> cancelled{false};
+    std::string error;
+
+    std::vector<uint64_t> columns;  // current chunk, CHUNK_WORDS words per output
+    std::vector<std::vector<uint64_t>> workerBlocks;
+    std::string buffer;
+
+    void evaluateChunk(uint64_t firstRow, uint64_t rows);
+    void writeHeader(std::ostream &out, ExportFormat format);
+    void writeChunk(std::ostream &out, ExportFormat format, uint64_t firstRow, uint64_t rows);
+    void writeFooter(std::ostream &out, ExportFormat format);
+};
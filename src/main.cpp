@@ -22,6 +22,7 @@ int main() {
     sf::RenderWindow window(sf::VideoMode({static_cast<unsigned int>(windowSize.x), static_cast<unsigned int>(windowSize.y)}), "Digital Logic Suite",
                             sf::Style::Default);
     window.setPosition({static_cast<int>((desktop.size.x - windowSize.x) / 2), static_cast<int>((desktop.size.y - windowSize.y) / 2)});
+    window.setFramerateLimit(60);  // don't spin a full core redrawing an idle scene
 
     // Core systems
     Simulator simulator;
@@ -49,6 +50,40 @@ int main() {
                     case sf::Keyboard::Scancode::T:
                         simulator.generateTruthTable();
                         break;
+                    case sf::Keyboard::Scancode::X:
+                        if (keyPressed->control)
+                            simulator.exportTruthTable(ExportFormat::BINARY);
+                        else if (keyPressed->shift)
+                            simulator.exportTruthTable(ExportFormat::PLA);
+                        else
+                            simulator.exportTruthTable(ExportFormat::CSV);
+                        break;
+                    case sf::Keyboard::Scancode::N:
+                        simulator.cycleEvaluatorBackend();
+                        break;
+                    case sf::Keyboard::Scancode::M:
+                        simulator.cycleMinimizeMode();
+                        break;
+                    case sf::Keyboard::Scancode::B:
+                        simulator.analyzeWithBdd();
+                        break;
+                    case sf::Keyboard::Scancode::H:
+                        simulator.analyzeHazards();
+                        break;
+                    case sf::Keyboard::Scancode::K:
+                        simulator.stepClock(keyPressed->shift);
+                        break;
+                    case sf::Keyboard::Scancode::V:
+                        if (keyPressed->control)
+                            simulator.verifyAgainstReference();
+                        else if (keyPressed->shift)
+                            simulator.saveReferenceCircuit();
+                        else
+                            simulator.verifyAgainstExpression();
+                        break;
+                    case sf::Keyboard::Scancode::G:
+                        simulator.generateCircuit(keyPressed->shift);
+                        break;
                     case sf::Keyboard::Scancode::E:
                         simulator.generateLogicalExpression();
                         break;
@@ -93,10 +128,9 @@ int main() {
             simulator.handleEvent(*event, window, canvas.getView(), palette.getSelectedGateType());
         }
 
-        // Update systems
+        // Update systems (canvas updates the simulator it draws)
         canvas.update();
         palette.update();
-        simulator.update();
 
         // Draw
         window.clear(sf::Color(30, 30, 30));
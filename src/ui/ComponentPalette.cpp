@@ -15,15 +15,22 @@ const float TOP_MARGIN = 40.f;   // vertical space
 const float SPACING = 25.f;      // vertical space
 
 // Spacing
-const float BOX_WIDTH = 180.f;                         // box width
-const float BOX_HEIGHT = 60.f;                         // box height
-const float BOX_Y_SPACING = BOX_HEIGHT + SPACING;      // distance between boxes
+const float BOX_WIDTH = 180.f;                         // title box width, spanned by the button grid
+const float BOX_HEIGHT = 60.f;                         // title box height
+const float BOX_Y_SPACING = BOX_HEIGHT + SPACING;      // distance between title and buttons
 const float BOX_Y_START = BOX_Y_SPACING + TOP_MARGIN;  // first button Y start
 
+// Buttons sit in a grid so all components and the controls fit the window height
+const size_t BUTTON_COLUMNS = 2;
+const float BUTTON_GAP = 8.f;                                                          // between columns and rows
+const float BUTTON_WIDTH = (BOX_WIDTH - BUTTON_GAP * (BUTTON_COLUMNS - 1)) / BUTTON_COLUMNS;  // button width
+const float BUTTON_HEIGHT = 40.f;                                                      // button height
+const float INSTRUCTION_SPACING = 22.f;                                                // distance between instruction lines
+
 // Font Sizes
 const unsigned int FONT_TITLE = 20;
-const unsigned int FONT_LABEL = 18;
-const unsigned int FONT_INSTRUCTION = 18;
+const unsigned int FONT_LABEL = 16;
+const unsigned int FONT_INSTRUCTION = 16;
 
 // Colors
 const sf::Color COLOR_SELECTED = sf::Color::Yellow;
@@ -47,7 +54,8 @@ ComponentPalette::ComponentPalette() {
     uiView.setCenter(paletteSize / 2.f);
     uiView.setViewport(sf::FloatRect({0, 0}, {WindowConfig::PALETTE_SCALE, 1}));
 
-    type = {GateType::INPUT, GateType::AND, GateType::OR, GateType::NOT, GateType::NAND, GateType::NOR, GateType::XOR, GateType::OUTPUT};
+    type = {GateType::INPUT, GateType::OUTPUT, GateType::AND, GateType::OR,  GateType::NOT,
+            GateType::NAND,  GateType::NOR,    GateType::XOR, GateType::DFF, GateType::LATCH, GateType::CLOCK};
     setupButtons();
 }
 
@@ -55,8 +63,10 @@ void ComponentPalette::setupButtons() {
     buttons.clear();
 
     for (size_t i = 0; i < type.size(); ++i) {
-        sf::RectangleShape button({BOX_WIDTH, BOX_HEIGHT});
-        button.setPosition({LEFT_MARGIN, BOX_Y_START + i * BOX_Y_SPACING});
+        sf::RectangleShape button({BUTTON_WIDTH, BUTTON_HEIGHT});
+        const float column = static_cast<float>(i % BUTTON_COLUMNS);
+        const float row = static_cast<float>(i / BUTTON_COLUMNS);
+        button.setPosition({LEFT_MARGIN + column * (BUTTON_WIDTH + BUTTON_GAP), BOX_Y_START + row * (BUTTON_HEIGHT + BUTTON_GAP)});
 
         if (i == selectedIndex)
             button.setFillColor(COLOR_SELECTED);
@@ -112,16 +122,19 @@ void ComponentPalette::setupTexts() {
                             TOP_MARGIN + (BOX_HEIGHT - tBounds.size.y) / 2.f - tBounds.position.y});
 
     // Instructions
-    float instrStartY = BOX_Y_START + type.size() * BOX_Y_SPACING + SPACING;
-    std::vector<std::string> instructions = {"CONTROLS:",   "T      Truth Table", "E      Expression", "I       Input Expression",
-                                             "C     Clear", "Del   Delete",       "Q     Quit"};
+    const size_t rows = (type.size() + BUTTON_COLUMNS - 1) / BUTTON_COLUMNS;
+    float instrStartY = BOX_Y_START + rows * (BUTTON_HEIGHT + BUTTON_GAP) + SPACING;
+    std::vector<std::string> instructions = {"CONTROLS:",          "T      Truth Table",  "X      Export Table", "N      Evaluator",
+                                             "M      Minimizer",   "B      BDD Analysis", "H      Hazards",       "K      Clock Cycle",
+                                             "V      Verify",      "G      Generate",     "E      Expression",    "I       Input Expression",
+                                             "C     Clear",        "Del   Delete",        "Q     Quit"};
 
     for (size_t i = 0; i < instructions.size(); ++i) {
         sf::Text instr(*currentFont);
         instr.setString(instructions[i]);
         instr.setCharacterSize(FONT_INSTRUCTION);
         instr.setFillColor(COLOR_INSTR_TEXT);
-        instr.setPosition({LEFT_MARGIN, instrStartY + i * SPACING});
+        instr.setPosition({LEFT_MARGIN, instrStartY + i * INSTRUCTION_SPACING});
         instructionTexts.push_back(instr);
     }
 }
@@ -215,6 +228,12 @@ std::string ComponentPalette::getGateTypeName(GateType type) const {
             return "XOR";
         case GateType::OUTPUT:
             return "OUTPUT";
+        case GateType::DFF:
+            return "DFF";
+        case GateType::LATCH:
+            return "LATCH";
+        case GateType::CLOCK:
+            return "CLOCK";
         default:
             return "UNKNOWN";
     }